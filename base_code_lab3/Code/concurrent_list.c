@@ -0,0 +1,187 @@
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <pthread.h>
+
+#include "concurrent_list.h"
+
+/* Size of a cache line, the two ends of a list are kept on distinct cache lines. */
+#define CACHE_LINE_SIZE 64
+
+typedef struct s_LinkedElement {
+	int value;
+	struct s_LinkedElement* previous;
+	struct s_LinkedElement* next;
+} LinkedElement;
+
+typedef struct s_ListEnd {
+	pthread_mutex_t lock;
+	LinkedElement sentinel;
+} ListEnd;
+
+/* The list is delimited by a sentinel at each end, each one being modified only under the lock of its end.
+   size counts the elements that can still be claimed by a pop operator : it is incremented once an element is linked
+   and decremented before an element is unlinked, so that it never exceeds the number of linked elements.
+   An operator working on one end only holds the lock of this end if it can not reach an element the other end may modify,
+   that is, if the list keeps at least one element the other end can not claim. Otherwise it takes both locks, front first. */
+struct s_List {
+	ListEnd front;
+	char front_padding[CACHE_LINE_SIZE];
+	ListEnd back;
+	char back_padding[CACHE_LINE_SIZE];
+	int size;
+};
+
+int list_load_size(const List* l) {
+	return __atomic_load_n(&(l->size), __ATOMIC_ACQUIRE);
+}
+
+/* Claim an element if at least two elements remain. Returns false when the operator must take both locks. */
+bool list_claim(List* l) {
+	int size = list_load_size(l);
+	while (size > 1)
+		if (__atomic_compare_exchange_n(&(l->size), &size, size - 1, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE))
+			return true;
+	return false;
+}
+
+void list_lock_both(List* l) {
+	pthread_mutex_lock(&(l->front.lock));
+	pthread_mutex_lock(&(l->back.lock));
+}
+
+void list_unlock_both(List* l) {
+	pthread_mutex_unlock(&(l->back.lock));
+	pthread_mutex_unlock(&(l->front.lock));
+}
+
+void linkedelement_link(LinkedElement* e, LinkedElement* previous, LinkedElement* next) {
+	e->previous = previous;
+	e->next = next;
+	previous->next = e;
+	next->previous = e;
+}
+
+int linkedelement_unlink(LinkedElement* e) {
+	int v = e->value;
+	e->previous->next = e->next;
+	e->next->previous = e->previous;
+	free(e);
+	return v;
+}
+
+List* list_create(void) {
+	List* l = malloc(sizeof(struct s_List));
+	pthread_mutex_init(&(l->front.lock), NULL);
+	pthread_mutex_init(&(l->back.lock), NULL);
+	l->front.sentinel.previous = NULL;
+	l->front.sentinel.next = &(l->back.sentinel);
+	l->back.sentinel.previous = &(l->front.sentinel);
+	l->back.sentinel.next = NULL;
+	l->size = 0;
+	return l;
+}
+
+void list_delete(ptrList* l) {
+	LinkedElement* elem = (*l)->front.sentinel.next;
+	while (elem != &((*l)->back.sentinel)) {
+		LinkedElement* next = elem->next;
+		free(elem);
+		elem = next;
+	}
+	pthread_mutex_destroy(&((*l)->front.lock));
+	pthread_mutex_destroy(&((*l)->back.lock));
+	free(*l);
+	*l = NULL;
+}
+
+List* list_push_front(List* l, int v) {
+	LinkedElement* e = malloc(sizeof(LinkedElement));
+	e->value = v;
+	pthread_mutex_lock(&(l->front.lock));
+	if (list_load_size(l) > 0) {
+		linkedelement_link(e, &(l->front.sentinel), l->front.sentinel.next);
+		__atomic_add_fetch(&(l->size), 1, __ATOMIC_RELEASE);
+		pthread_mutex_unlock(&(l->front.lock));
+	} else {
+		pthread_mutex_lock(&(l->back.lock));
+		linkedelement_link(e, &(l->front.sentinel), l->front.sentinel.next);
+		__atomic_add_fetch(&(l->size), 1, __ATOMIC_RELEASE);
+		list_unlock_both(l);
+	}
+	return l;
+}
+
+List* list_push_back(List* l, int v) {
+	LinkedElement* e = malloc(sizeof(LinkedElement));
+	e->value = v;
+	pthread_mutex_lock(&(l->back.lock));
+	if (list_load_size(l) > 0) {
+		linkedelement_link(e, l->back.sentinel.previous, &(l->back.sentinel));
+		__atomic_add_fetch(&(l->size), 1, __ATOMIC_RELEASE);
+		pthread_mutex_unlock(&(l->back.lock));
+	} else {
+		pthread_mutex_unlock(&(l->back.lock));
+		list_lock_both(l);
+		linkedelement_link(e, l->back.sentinel.previous, &(l->back.sentinel));
+		__atomic_add_fetch(&(l->size), 1, __ATOMIC_RELEASE);
+		list_unlock_both(l);
+	}
+	return l;
+}
+
+bool list_try_pop_front(List* l, int* v) {
+	pthread_mutex_lock(&(l->front.lock));
+	if (list_claim(l)) {
+		*v = linkedelement_unlink(l->front.sentinel.next);
+		pthread_mutex_unlock(&(l->front.lock));
+		return true;
+	}
+	pthread_mutex_lock(&(l->back.lock));
+	bool found = (list_load_size(l) > 0);
+	if (found) {
+		__atomic_sub_fetch(&(l->size), 1, __ATOMIC_ACQ_REL);
+		*v = linkedelement_unlink(l->front.sentinel.next);
+	}
+	list_unlock_both(l);
+	return found;
+}
+
+bool list_try_pop_back(List* l, int* v) {
+	pthread_mutex_lock(&(l->back.lock));
+	if (list_claim(l)) {
+		*v = linkedelement_unlink(l->back.sentinel.previous);
+		pthread_mutex_unlock(&(l->back.lock));
+		return true;
+	}
+	pthread_mutex_unlock(&(l->back.lock));
+	list_lock_both(l);
+	bool found = (list_load_size(l) > 0);
+	if (found) {
+		__atomic_sub_fetch(&(l->size), 1, __ATOMIC_ACQ_REL);
+		*v = linkedelement_unlink(l->back.sentinel.previous);
+	}
+	list_unlock_both(l);
+	return found;
+}
+
+List* list_pop_front(List* l) {
+	int v;
+	list_try_pop_front(l, &v);
+	return l;
+}
+
+List* list_pop_back(List* l) {
+	int v;
+	list_try_pop_back(l, &v);
+	return l;
+}
+
+bool list_is_empty(const List* l) {
+	return (list_load_size(l) == 0);
+}
+
+int list_size(const List* l) {
+	return list_load_size(l);
+}
@@ -0,0 +1,131 @@
+/*-----------------------------------------------------------------*/
+/*
+ Licence Informatique - Structures de données
+
+ Interface pour l'implantation concurrente des opérations de file à double entrée du TAD List.
+*/
+/*-----------------------------------------------------------------*/
+
+#ifndef __CONCURRENT_LIST_H__
+#define __CONCURRENT_LIST_H__
+
+#include <stdbool.h>
+
+/*-----------------------------------------------------------------*/
+
+/** \defgroup ADTConcurrentList Concurrent List
+ Documentation of the thread safe implementation of the front and back operators of the abstract data type List.
+
+ This module is an alternative to list.h for lists shared by several threads and used as a double ended queue :
+ it keeps the names of the operators of list.h so that such code only has to change the included header and the linked implementation.
+ Both modules can not be linked in the same program.
+
+ Each end of the list is protected by its own lock, so that one thread working at the front and one thread working at the back
+ do not wait for each other. When the list holds too few elements for the two ends to be independent,
+ an operator takes both locks. An element is released by the thread removing it while holding the lock of its end,
+ no other thread can reach it at that time, so no deferred reclamation is needed.
+ @{
+*/
+
+/** \defgroup ConcurrentType Type definition.
+  @{
+*/
+/** Opaque definition of type List.
+*/
+typedef struct s_List List;
+/** Définition of type ptrList : pointer to a List.
+*/
+typedef List* ptrList;
+/** @}*/
+
+/*-----------------------------------------------------------------*/
+
+/** \defgroup ConcurrentConstructors Contructors and destructors of the TAD.
+ @{
+*/
+/** Implementation of the the constructor \c list from the specification.
+*/
+List* list_create(void);
+
+/** Implementation of the the constructor \c push_back from the specification.
+ @param l The list to modify
+ @param v The value to add
+ @return The modified list
+ Add the value v at the end of the list l. May be called concurrently with any other operator but list_delete.
+ @note This function acts by side effect on the parameter l. The returned value is the same as the parameter l that is modified by the function.
+*/
+List* list_push_back(List* l, int v);
+
+/** Destructor.
+	Free ressources allocated by constructors.
+ 	@param l the adress of the list.
+ 	After calling this function, the list l becomes NULL.
+ 	@pre No other thread uses the list.
+*/
+void list_delete(ptrList* l);
+/** @}*/
+
+/*-----------------------------------------------------------------*/
+
+/** \defgroup ConcurrentFrontBackOperators Insertion and removal of elements at front or back of the list.
+ These operators have a time complexity in O(1) and may be called concurrently.
+ @{
+*/
+/** Add an element at the front of the list.
+ 	@param l The list to modify
+ 	@param v The value to add
+ 	@return The modified list
+ 	@note This function acts by side effect on the parameter l. The returned value is the same as the parameter l that is modified by the function.
+*/
+List* list_push_front(List* l, int v);
+
+/** Remove the element at begining of the list.
+ 	@return The modified list
+ 	@note This function acts by side effect on the parameter l. The returned value is the same as the parameter l that is modified by the function.
+  	@pre !empty(l)
+*/
+List* list_pop_front(List* l);
+
+/** Remove the element at end of the list.
+ 	@return The modified list
+ 	@note This function acts by side effect on the parameter l. The returned value is the same as the parameter l that is modified by the function.
+ 	@pre !empty(l)
+*/
+List* list_pop_back(List* l);
+
+/** Remove the element at begining of the list, if any, and give its value.
+ 	@param l The list to modify
+ 	@param v Where to store the value of the removed element
+ 	@return true if an element was removed, false if the list was empty.
+ 	Reading the front of a list then removing it can not be done with two calls when other threads remove elements, this operator does both at once.
+*/
+bool list_try_pop_front(List* l, int* v);
+
+/** Remove the element at end of the list, if any, and give its value.
+ 	@param l The list to modify
+ 	@param v Where to store the value of the removed element
+ 	@return true if an element was removed, false if the list was empty.
+ 	@see list_try_pop_front
+*/
+bool list_try_pop_back(List* l, int* v);
+/** @}*/
+
+/*-----------------------------------------------------------------*/
+
+/** \defgroup ConcurrentUtilityOperators Operators allowing to access some properties of the list.
+ @{
+*/
+/** Test if a list is empty.
+ @note When other threads modify the list, the result may be outdated as soon as it is returned.
+*/
+bool list_is_empty(const List* l);
+
+/** Give the number of elements of the list.
+ @note When other threads modify the list, the result may be outdated as soon as it is returned.
+*/
+int list_size(const List* l);
+/** @}*/
+
+/** @}*/
+
+#endif
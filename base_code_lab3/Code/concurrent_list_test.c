@@ -0,0 +1,134 @@
+/*-----------------------------------------------------------------*/
+/** \defgroup ConcurrentMain concurrent_main
+ Test of the concurrent implementation of the double ended queue operators of the abstract data type List.
+
+ \code{.unparsed}
+ $ ./concurrent_list_test 4
+ -------- TEST SEQUENTIAL --------
+ List (6) : 2 1 0 3 4 5
+ -------- TEST CONCURRENT --------
+ 4 producers, 4 consumers : 400000 values pushed, 400000 values popped, same sum
+ $
+ \endcode
+ @{
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <pthread.h>
+#include "concurrent_list.h"
+
+/** Number of values pushed by each producer.
+ */
+#define NB_VALUES 100000
+
+/** Shared state of the test threads.
+ */
+typedef struct s_TestEnv {
+	List* list;
+	int producers_running;
+	pthread_mutex_t lock;
+} TestEnv;
+
+/** Result of a test thread.
+ */
+typedef struct s_ThreadData {
+	TestEnv* env;
+	int rank;
+	long long sum;
+	int count;
+	pthread_t thread;
+} ThreadData;
+
+/** Producers alternatively push at the front and at the back of the list.
+ */
+void* producer(void* arg) {
+	ThreadData* data = (ThreadData*)arg;
+	for (int i = 0; i < NB_VALUES; ++i) {
+		int v = data->rank * NB_VALUES + i;
+		if (i % 2)
+			list_push_back(data->env->list, v);
+		else
+			list_push_front(data->env->list, v);
+		data->sum += v;
+		data->count++;
+	}
+	pthread_mutex_lock(&(data->env->lock));
+	data->env->producers_running--;
+	pthread_mutex_unlock(&(data->env->lock));
+	return NULL;
+}
+
+/** Consumers pop from the front or the back of the list, according to their rank, until the producers are done and the list is empty.
+ */
+void* consumer(void* arg) {
+	ThreadData* data = (ThreadData*)arg;
+	for (;;) {
+		int v;
+		if (data->rank % 2 ? list_try_pop_back(data->env->list, &v) : list_try_pop_front(data->env->list, &v)) {
+			data->sum += v;
+			data->count++;
+			continue;
+		}
+		pthread_mutex_lock(&(data->env->lock));
+		int running = data->env->producers_running;
+		pthread_mutex_unlock(&(data->env->lock));
+		if (running == 0 && list_is_empty(data->env->list))
+			break;
+	}
+	return NULL;
+}
+
+/** Main function of the test program.
+ */
+int main(int argc, char** argv){
+	int nbthreads = (argc < 2 ? 4 : atoi(argv[1]));
+	if (nbthreads < 1) {
+		fprintf(stderr,"usage : %s nb_threads\n", argv[0]);
+		return 1;
+	}
+
+	printf("-------- TEST SEQUENTIAL --------\n");
+	List* l = list_create();
+	for (int i = 0; i < 3; ++i)
+		list_push_front(l, i);
+	for (int i = 3; i < 7; ++i)
+		list_push_back(l, i);
+	list_push_back(list_pop_back(l), 5);
+	list_pop_back(l);
+	list_pop_back(l);
+	list_push_back(l, 5);
+	printf("List (%d) : ", list_size(l));
+	int v;
+	while (list_try_pop_front(l, &v))
+		printf("%d ", v);
+	printf("\n");
+
+	printf("-------- TEST CONCURRENT --------\n");
+	TestEnv env = {l, nbthreads, PTHREAD_MUTEX_INITIALIZER};
+	ThreadData* producers = calloc(nbthreads, sizeof(ThreadData));
+	ThreadData* consumers = calloc(nbthreads, sizeof(ThreadData));
+	for (int t = 0; t < nbthreads; ++t) {
+		producers[t].env = consumers[t].env = &env;
+		producers[t].rank = consumers[t].rank = t;
+		pthread_create(&(consumers[t].thread), NULL, consumer, &consumers[t]);
+		pthread_create(&(producers[t].thread), NULL, producer, &producers[t]);
+	}
+	long long pushed = 0, popped = 0;
+	int nbpushed = 0, nbpopped = 0;
+	for (int t = 0; t < nbthreads; ++t) {
+		pthread_join(producers[t].thread, NULL);
+		pthread_join(consumers[t].thread, NULL);
+		pushed += producers[t].sum;
+		nbpushed += producers[t].count;
+		popped += consumers[t].sum;
+		nbpopped += consumers[t].count;
+	}
+	printf("%d producers, %d consumers : %d values pushed, %d values popped, %s\n", nbthreads, nbthreads, nbpushed, nbpopped,
+		   (pushed == popped ? "same sum" : "different sums"));
+	free(producers);
+	free(consumers);
+	list_delete(&l);
+	return (nbpushed == nbpopped && pushed == popped ? 0 : 1);
+}
+/** @} */
@@ -1,12 +1,16 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <assert.h>
+#include <pthread.h>
 
 #include "list.h"
 
 
 typedef struct s_LinkedElement {
 	int value;
+	/* Offset of the element in the block it was allocated with, 0 if allocated alone.
+	   The first element of a block is not part of the list and counts the live elements of the block in its value. */
+	int block_offset;
 	struct s_LinkedElement* previous;
 	struct s_LinkedElement* next;
 } LinkedElement;
@@ -22,9 +26,47 @@ typedef struct s_SubList {
 } SubList;
 
 
+LinkedElement* linkedelement_create(int v) {
+	LinkedElement* e = malloc(sizeof(LinkedElement));
+	e->value = v;
+	e->block_offset = 0;
+	return e;
+}
+
+void linkedelement_delete(LinkedElement* e) {
+	if (e->block_offset == 0)
+		free(e);
+	else {
+		LinkedElement* block = e - e->block_offset;
+		if (--(block->value) == 0)
+			free(block);
+	}
+}
+
+/* Element at position p, 0 <= p <= size, the sentinel being at position size. The walk starts from the nearest end. */
+LinkedElement* list_element_at(const List* l, int p) {
+	LinkedElement* posi;
+	if (p <= l->size / 2)
+		for (posi = l->sentinel->next; p > 0; --p, posi = posi->next);
+	else
+		for (posi = l->sentinel, p = l->size - p; p > 0; --p, posi = posi->previous);
+	return posi;
+}
+
+/* Unlink the range first..last (included) and relink it just before the element posi. */
+void linkedelement_move_range(LinkedElement* first, LinkedElement* last, LinkedElement* posi) {
+	first->previous->next = last->next;
+	last->next->previous = first->previous;
+	first->previous = posi->previous;
+	last->next = posi;
+	posi->previous->next = first;
+	posi->previous = last;
+}
+
 List* list_create(void) {
 	List* l = malloc(sizeof(struct s_List) + sizeof(struct s_LinkedElement));
 	l->sentinel = (LinkedElement*)(l+1);
+	l->sentinel->block_offset = 0;
 	l->sentinel->next = l->sentinel;
 	l->sentinel->previous = l->sentinel;
 	l->size = 0;
@@ -38,7 +80,7 @@ void list_delete(ptrList* l) {
 	for (LinkedElement *elem = prev_elem->next; elem != (*l)->sentinel->next; elem = elem->next) {
 		prev_elem->next = NULL;
 		elem->previous = NULL;
-		free(prev_elem);
+		linkedelement_delete(prev_elem);
 		prev_elem = elem;
 	}
 	free(*l);
@@ -46,8 +88,7 @@ void list_delete(ptrList* l) {
 }
 
 List* list_push_back(List* l, int v) {
-	LinkedElement* e = malloc(sizeof(LinkedElement));
-	e->value = v;
+	LinkedElement* e = linkedelement_create(v);
 	e->next = l->sentinel;
 	e->previous = e->next->previous;
 	e->previous->next = e;
@@ -56,12 +97,130 @@ List* list_push_back(List* l, int v) {
 	return l;
 }
 
+List* list_from_array(const int* values, int n) {
+	return list_append_array(list_create(), values, n);
+}
+
+List* list_append_array(List* l, const int* values, int n) {
+	if (n <= 0)
+		return l;
+	LinkedElement* block = malloc((n + 1) * sizeof(LinkedElement));
+	block->value = n;
+	block->block_offset = 0;
+	LinkedElement* last = l->sentinel->previous;
+	for (int i = 1; i <= n; ++i) {
+		block[i].value = values[i-1];
+		block[i].block_offset = i;
+		block[i].previous = last;
+		last->next = block + i;
+		last = block + i;
+	}
+	last->next = l->sentinel;
+	l->sentinel->previous = last;
+	l->size += n;
+	return l;
+}
+
+int* list_to_array(const List* l, int* values) {
+	int i = 0;
+	for (LinkedElement *elem = l->sentinel->next; elem != l->sentinel; elem = elem->next)
+		values[i++] = elem->value;
+	return values;
+}
+
+List* list_assign_array(List* l, const int* values) {
+	int i = 0;
+	for (LinkedElement *elem = l->sentinel->next; elem != l->sentinel; elem = elem->next)
+		elem->value = values[i++];
+	return l;
+}
+
 List* list_map(List* l, ListFunctor f, void* environment) {
 	for (LinkedElement *elem = l->sentinel->next; elem != l->sentinel; elem = elem->next)
 		elem->value = f(elem->value, environment);
 	return l;
 }
 
+int list_reduce(const List* l, ReduceFunctor f, int init, void* environment) {
+	int acc = init;
+	for (LinkedElement *elem = l->sentinel->next; elem != l->sentinel; elem = elem->next)
+		acc = f(acc, elem->value, environment);
+	return acc;
+}
+
+typedef struct s_ReduceTask {
+	LinkedElement* first;
+	int count;
+	ReduceFunctor f;
+	void* environment;
+	int result;
+	pthread_t thread;
+	bool spawned;
+} ReduceTask;
+
+void* reduce_task_run(void* arg) {
+	ReduceTask* task = (ReduceTask*)arg;
+	LinkedElement* elem = task->first;
+	int acc = elem->value;
+	for (int i = 1; i < task->count; ++i) {
+		elem = elem->next;
+		acc = task->f(acc, elem->value, task->environment);
+	}
+	task->result = acc;
+	return NULL;
+}
+
+/* Fold a segment in a new thread, or in the calling thread if the thread cannot be created. */
+void reduce_task_start(ReduceTask* task) {
+	task->spawned = (pthread_create(&task->thread, NULL, reduce_task_run, task) == 0);
+	if (!task->spawned)
+		reduce_task_run(task);
+}
+
+int list_parallel_reduce(const List* l, ReduceFunctor f, int init, void* environment, int nbthreads) {
+	if (nbthreads > l->size)
+		nbthreads = l->size;
+	if (nbthreads <= 1)
+		return list_reduce(l, f, init, environment);
+
+	ReduceTask* tasks = malloc(nbthreads * sizeof(ReduceTask));
+	for (int t = 0; t < nbthreads; ++t) {
+		tasks[t].count = (int)((long long)(t + 1) * l->size / nbthreads - (long long)t * l->size / nbthreads);
+		tasks[t].f = f;
+		tasks[t].environment = environment;
+	}
+	/* Segment starts of the first half are found from the front, the others from the back. Each thread is started as soon as
+	   the start of its segment is found, so that the walk overlaps the folds. The calling thread folds the segment whose start
+	   is found last. */
+	int half = nbthreads / 2;
+	LinkedElement* elem = l->sentinel->next;
+	for (int t = 0, p = 0; t < half; ++t) {
+		int start = (int)((long long)t * l->size / nbthreads);
+		for (; p < start; ++p, elem = elem->next);
+		tasks[t].first = elem;
+		reduce_task_start(&tasks[t]);
+	}
+	elem = l->sentinel->previous;
+	for (int t = nbthreads - 1, p = l->size - 1; t >= half; --t) {
+		int start = (int)((long long)t * l->size / nbthreads);
+		for (; p > start; --p, elem = elem->previous);
+		tasks[t].first = elem;
+		if (t > half)
+			reduce_task_start(&tasks[t]);
+	}
+	tasks[half].spawned = false;
+	reduce_task_run(&tasks[half]);
+
+	int acc = init;
+	for (int t = 0; t < nbthreads; ++t) {
+		if (tasks[t].spawned)
+			pthread_join(tasks[t].thread, NULL);
+		acc = f(acc, tasks[t].result, environment);
+	}
+	free(tasks);
+	return acc;
+}
+
 bool list_is_empty(const List* l) {
 	return (l->size == 0);
 }
@@ -71,8 +230,7 @@ int list_size(const List* l) {
 }
 
 List* list_push_front(List* l, int v) {
-	LinkedElement* e = malloc(sizeof(LinkedElement));
-	e->value = v;
+	LinkedElement* e = linkedelement_create(v);
 	e->previous = l->sentinel;
 	e->next = e->previous->next;
 	e->previous->next = e;
@@ -93,7 +251,7 @@ List* list_pop_front(List* l) {
 	LinkedElement* elem = l->sentinel->next;
 	l->sentinel->next = elem->next;
 	l->sentinel->next->previous = l->sentinel;
-	free(elem);
+	linkedelement_delete(elem);
 	(l->size)--;
 	return l;
 }
@@ -102,18 +260,16 @@ List* list_pop_back(List* l){
 	LinkedElement* elem = l->sentinel->previous;
 	l->sentinel->previous = elem->previous;
 	l->sentinel->previous->next = l->sentinel;
-	free(elem);
+	linkedelement_delete(elem);
 	(l->size)--;
 	return l;
 }
 
 List* list_insert_at(List* l, int p, int v) {
-	LinkedElement* e = malloc(sizeof(LinkedElement));
-	e->value = v;
-	LinkedElement* posi = l->sentinel;
-	for (; p > 0; p--, posi = posi->next);
-	e->previous = posi;
-	e->next = posi->next;
+	LinkedElement* e = linkedelement_create(v);
+	LinkedElement* posi = list_element_at(l, p);
+	e->next = posi;
+	e->previous = posi->previous;
 	e->previous->next = e;
 	e->next->previous = e;
 	(l->size)++;
@@ -122,26 +278,57 @@ List* list_insert_at(List* l, int p, int v) {
 
 List* list_remove_at(List* l, int p) {
 	if (p >= 0 && p < list_size(l)) {
-		LinkedElement* posi = l->sentinel->next;
-		for (; p > 0; --p, posi = posi->next);
+		LinkedElement* posi = list_element_at(l, p);
 		posi->previous->next = posi->next;
 		posi->next->previous = posi->previous;
-		free(posi);
+		linkedelement_delete(posi);
 		(l->size)--;
 	}
 	return l;
 }
 
 int list_at(const List* l, int p) {
-	if (p >= 0 && p < list_size(l)) {
-		LinkedElement* posi = l->sentinel->next;
-		for (; p > 0; --p, posi = posi->next);
-		return posi->value;
-	}
+	if (p >= 0 && p < list_size(l))
+		return list_element_at(l, p)->value;
 	else
 		return 0;
 }
 
+List* list_concat(List* l1, List* l2) {
+	if (l2->size > 0) {
+		linkedelement_move_range(l2->sentinel->next, l2->sentinel->previous, l1->sentinel);
+		l1->size += l2->size;
+		l2->size = 0;
+	}
+	return l1;
+}
+
+List* list_split_at(List* l, int p) {
+	List* tail = list_create();
+	if (p < l->size) {
+		linkedelement_move_range(list_element_at(l, p), l->sentinel->previous, tail->sentinel);
+		tail->size = l->size - p;
+		l->size = p;
+	}
+	return tail;
+}
+
+List* list_splice(List* l, int p, List* other, int first, int count) {
+	if (count > 0) {
+		LinkedElement* posi = list_element_at(l, p);
+		LinkedElement* begin = list_element_at(other, first);
+		LinkedElement* end = begin;
+		/* Walk from the first element of the range unless the end of other is nearer. */
+		if (count - 1 <= other->size - (first + count - 1))
+			for (int i = 1; i < count; ++i, end = end->next);
+		else
+			end = list_element_at(other, first + count - 1);
+		linkedelement_move_range(begin, end, posi);
+		l->size += count;
+		other->size -= count;
+	}
+	return l;
+}
 
 SubList sublist_create(void) {
 	SubList sl;
@@ -150,9 +337,7 @@ SubList sublist_create(void) {
 	return sl;
 }
 
-SubList sublist_push_back(SubList sl, LinkedElement* old) {
-	LinkedElement* e = malloc(sizeof(LinkedElement));
-	e->value = old->value;
+SubList sublist_push_back(SubList sl, LinkedElement* e) {
 	e->next = NULL;
 	if (sl.head == NULL) {
 		sl.head = e;
@@ -163,7 +348,6 @@ SubList sublist_push_back(SubList sl, LinkedElement* old) {
 		sl.tail->next = e;
 	}
 	sl.tail = e;
-	free(old);
 	return sl;
 }
 
@@ -236,6 +420,12 @@ SubList list_mergesort(SubList l, OrderFunctor f) {
 }
 
 List* list_sort(List* l, OrderFunctor f) {
+	if (l->size < 2)
+		return l;
+	if (f == list_order_increasing)
+		return list_sort_increasing(l);
+	if (f == list_order_decreasing)
+		return list_sort_decreasing(l);
 	SubList list = sublist_create();
 	list.head = l->sentinel->next;
 	list.tail = l->sentinel->previous;
@@ -251,3 +441,146 @@ List* list_sort(List* l, OrderFunctor f) {
 	return l;
 }
 
+
+bool list_order_increasing(int a, int b) {
+	return a < b;
+}
+
+bool list_order_decreasing(int a, int b) {
+	return a > b;
+}
+
+/* LSD radix sort on 8 bits digits of the keys. Signed values are mapped to unsigned keys preserving the order,
+   complemented for the decreasing order. */
+List* list_radix_sort(List* l, unsigned int keymask) {
+	if (l->size < 2)
+		return l;
+	unsigned int* keys = malloc(2 * l->size * sizeof(unsigned int));
+	unsigned int* scratch = keys + l->size;
+	int n = 0;
+	for (LinkedElement *elem = l->sentinel->next; elem != l->sentinel; elem = elem->next)
+		keys[n++] = ((unsigned int)elem->value ^ 0x80000000u) ^ keymask;
+
+	for (int shift = 0; shift < 32; shift += 8) {
+		int count[256] = {0};
+		for (int i = 0; i < n; ++i)
+			count[(keys[i] >> shift) & 0xFF]++;
+		if (count[(keys[0] >> shift) & 0xFF] == n)
+			continue;
+		for (int d = 0, start = 0; d < 256; ++d) {
+			int c = count[d];
+			count[d] = start;
+			start += c;
+		}
+		for (int i = 0; i < n; ++i)
+			scratch[count[(keys[i] >> shift) & 0xFF]++] = keys[i];
+		unsigned int* swap = keys;
+		keys = scratch;
+		scratch = swap;
+	}
+
+	n = 0;
+	for (LinkedElement *elem = l->sentinel->next; elem != l->sentinel; elem = elem->next)
+		elem->value = (int)((keys[n++] ^ keymask) ^ 0x80000000u);
+	free(keys < scratch ? keys : scratch);
+	return l;
+}
+
+List* list_sort_increasing(List* l) {
+	return list_radix_sort(l, 0u);
+}
+
+List* list_sort_decreasing(List* l) {
+	return list_radix_sort(l, 0xFFFFFFFFu);
+}
+
+
+#ifdef __GNUC__
+#define list_prefetch(address) __builtin_prefetch(address)
+#else
+#define list_prefetch(address) ((void)(address))
+#endif
+
+struct s_ListIterator {
+	List* list;
+	LinkedElement* current;
+	LinkedElement* ahead;
+	int prefetch_distance;
+	IteratorDirection direction;
+};
+
+LinkedElement* list_iterator_step(const ListIterator* it, LinkedElement* e) {
+	return (it->direction == FORWARD_ITERATOR ? e->next : e->previous);
+}
+
+ListIterator* list_iterator_create(List* l, IteratorDirection w) {
+	ListIterator* it = malloc(sizeof(struct s_ListIterator));
+	it->list = l;
+	it->direction = w;
+	it->prefetch_distance = 0;
+	return list_iterator_begin(it);
+}
+
+void list_iterator_delete(ptrListIterator* it) {
+	free(*it);
+	*it = NULL;
+}
+
+ListIterator* list_iterator_begin(ListIterator* it) {
+	it->current = list_iterator_step(it, it->list->sentinel);
+	return list_iterator_set_prefetch(it, it->prefetch_distance);
+}
+
+bool list_iterator_end(const ListIterator* it) {
+	return it->current == it->list->sentinel;
+}
+
+ListIterator* list_iterator_next(ListIterator* it) {
+	it->current = list_iterator_step(it, it->current);
+	if (it->prefetch_distance > 0 && it->ahead != it->list->sentinel) {
+		it->ahead = list_iterator_step(it, it->ahead);
+		list_prefetch(it->ahead);
+	}
+	return it;
+}
+
+int list_iterator_value(const ListIterator* it) {
+	return it->current->value;
+}
+
+ListIterator* list_iterator_insert(ListIterator* it, int v) {
+	LinkedElement* e = linkedelement_create(v);
+	if (it->direction == FORWARD_ITERATOR) {
+		e->next = it->current;
+		e->previous = it->current->previous;
+	} else {
+		e->previous = it->current;
+		e->next = it->current->next;
+	}
+	e->previous->next = e;
+	e->next->previous = e;
+	(it->list->size)++;
+	return it;
+}
+
+ListIterator* list_iterator_erase(ListIterator* it) {
+	LinkedElement* elem = it->current;
+	if (it->ahead == elem)
+		it->ahead = list_iterator_step(it, elem);
+	it->current = list_iterator_step(it, elem);
+	elem->previous->next = elem->next;
+	elem->next->previous = elem->previous;
+	linkedelement_delete(elem);
+	(it->list->size)--;
+	return it;
+}
+
+ListIterator* list_iterator_set_prefetch(ListIterator* it, int distance) {
+	it->prefetch_distance = (distance > 0 ? distance : 0);
+	it->ahead = it->current;
+	for (int i = 0; i < it->prefetch_distance && it->ahead != it->list->sentinel; ++i) {
+		it->ahead = list_iterator_step(it, it->ahead);
+		list_prefetch(it->ahead);
+	}
+	return it;
+}
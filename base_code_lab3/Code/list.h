@@ -36,11 +36,16 @@ typedef List* ptrList;
  @{
 */
 
-/** Functor with user data to be used with the list_reduce operator.
+/** Functor with user data to be used with the list_map operator.
   This functor receive as argument the value of a list element and an opaque pointer to user provided data and must return the eventually modified value of the element.
 */
 typedef int(*ListFunctor)(int, void*);
 
+/** Functor with user data to be used with the list_reduce operator.
+  This functor receive as argument the accumulated value, the value of a list element and an opaque pointer to user provided data and must return the new accumulated value.
+*/
+typedef int(*ReduceFunctor)(int, int, void*);
+
 /** Functor to be used with the list_sort operator.
    This functor must implement a total ordering function (comp). When calling this functor with two list elements a and b, this functor must return true if (a comp b).
 */
@@ -71,6 +76,25 @@ List* list_push_back(List* l, int v);
  	After calling this function, the list l becomes NULL.
 */
 void list_delete(ptrList* l);
+
+/** Build a list from an array of values.
+ @param values The values to add
+ @param n The number of values
+ @return A new list containing values[0] ... values[n-1] in this order
+ All the elements of the list are allocated at once.
+*/
+List* list_from_array(const int* values, int n);
+
+/** Add the values of an array at the end of the list.
+ @param l The list to modify
+ @param values The values to add
+ @param n The number of values
+ @return The modified list
+ All the added elements are allocated at once and linked in a single pass.
+ The memory of such a block of elements is released when the last of its elements is removed from the list.
+ @note This function acts by side effect on the parameter l. The returned value is the same as the parameter l that is modified by the function.
+*/
+List* list_append_array(List* l, const int* values, int n);
 /** @}*/
 
 /*-----------------------------------------------------------------*/
@@ -112,6 +136,16 @@ List* list_pop_front(List* l);
  	@pre !empty(l)
 */
 List* list_pop_back(List* l);
+
+/** Move all the elements of a list at the end of another one in constant time.
+ 	@param l1 The list to modify
+ 	@param l2 The list whose elements are moved
+ 	@return The modified list l1
+ 	After calling this function, l2 is empty.
+ 	@pre l1 != l2
+ 	@note This function acts by side effect on the parameters l1 and l2. The returned value is the same as the parameter l1 that is modified by the function.
+*/
+List* list_concat(List* l1, List* l2);
 /** @}*/
 
 /*-----------------------------------------------------------------*/
@@ -148,6 +182,31 @@ List* list_remove_at(List* l, int p);
 	 @pre 0 <= p < list_size(l)
 */
 int list_at(const List* l, int p);
+
+/** Move a range of elements from a list to a given position of another list.
+	 @param l The list to modify.
+	 @param p The position where the range is inserted in l.
+	 @param other The list the elements are taken from.
+	 @param first The position of the first element of the range in other.
+	 @param count The number of elements to move.
+	 @return The modified list l.
+	 The elements are relinked, not copied. Once positions are found, the move is done in constant time.
+	 @pre 0 <= p <= list_size(l)
+	 @pre 0 <= first && first + count <= list_size(other)
+	 @pre l != other
+	 @note This function acts by side effect on the parameters l and other. The returned value is the same as the parameter l that is modified by the function.
+*/
+List* list_splice(List* l, int p, List* other, int first, int count);
+
+/** Split a list at a given position.
+	 @param l The list to split.
+	 @param p The position of the first element of the new list.
+	 @return A new list containing the elements of l from position p to its end.
+	 The elements are relinked, not copied. l keeps its p first elements.
+	 @pre 0 <= p <= list_size(l)
+	 @note This function acts by side effect on the parameter l.
+*/
+List* list_split_at(List* l, int p);
 /** @}*/
 
 /*-----------------------------------------------------------------*/
@@ -163,6 +222,22 @@ bool list_is_empty(const List* l);
 */
 int list_size(const List* l);
 
+/** Copy the elements of the list in an array.
+ 	@param l The list to process.
+ 	@param values The array to fill, must be able to hold list_size(l) values
+ 	@return values, filled with the elements of the list from its beginning to its end
+**/
+int* list_to_array(const List* l, int* values);
+
+/** Replace the elements of the list by the values of an array.
+ 	@param l The list to modify.
+ 	@param values The new values, at least list_size(l) of them
+ 	@return The modified list, whose element at position i is values[i]
+ 	The elements of the list are not reallocated, only their values are overwritten.
+ 	@note This function acts by side effect on the parameter l. The returned value is the same as the parameter l that is modified by the function.
+**/
+List* list_assign_array(List* l, const int* values);
+
 /** Apply the same operator on each element of the list given a user define environment.
  	@param l The list to process.
  	@param f The operator (function) to apply to each element
@@ -173,6 +248,36 @@ int list_size(const List* l);
 **/
 List* list_map(List* l, ListFunctor f, void* environment);
 
+/** Fold the list from its beginning to its end with the given operator.
+ 	@param l The list to process.
+ 	@param f The operator combining the accumulated value with an element
+ 	@param init The initial accumulated value
+ 	@param environment User supplied data given to each call of f
+ 	@see ReduceFunctor
+ 	@return f(...f(f(init, e0, environment), e1, environment)..., en-1, environment) or init if the list is empty
+**/
+int list_reduce(const List* l, ReduceFunctor f, int init, void* environment);
+
+/** Fold the list with the given operator using several threads.
+ 	@param l The list to process.
+ 	@param f The operator combining two partial results, must be associative
+ 	@param init The initial accumulated value, combined once with the partial results
+ 	@param environment User supplied data given to each call of f, shared by all threads
+ 	@param nbthreads The number of threads to use
+ 	@see ReduceFunctor
+ 	@return the same value as list_reduce(l, f, init, environment) when f is associative.
+ 	The list is cut into nbthreads segments of consecutive elements. Each segment is folded by its own thread,
+ 	starting from its first element, then the partial results are combined in order with init.
+ 	@note environment is accessed concurrently and must not be modified by f.
+ 	@note The nbthreads - 1 threads are created and joined by each call, there is no pool of threads kept between calls : the
+ 	function is meant for long lists, whose fold costs much more than the creation of the threads.
+ 	@note The starts of the segments are found by walking the list from both ends, over half of its elements. Each thread is
+ 	started as soon as the start of its segment is found, but the last segments only begin after a walk over up to half of
+ 	the list : for an operator as cheap as a sum, which costs about as much as this walk, the speedup stays close to 2
+ 	whatever the number of threads.
+**/
+int list_parallel_reduce(const List* l, ReduceFunctor f, int init, void* environment, int nbthreads);
+
 /** Sort the list according to the provided ordering functor.
  @param l The list to sort.
  @param f The order to use
@@ -181,6 +286,114 @@ List* list_map(List* l, ListFunctor f, void* environment);
 */
 List* list_sort(List* l, OrderFunctor f);
 
+/** Natural increasing order on list elements.
+ @see OrderFunctor
+ @note When given to list_sort, the list is sorted with list_sort_increasing.
+*/
+bool list_order_increasing(int a, int b);
+
+/** Natural decreasing order on list elements.
+ @see OrderFunctor
+ @note When given to list_sort, the list is sorted with list_sort_decreasing.
+*/
+bool list_order_decreasing(int a, int b);
+
+/** Sort the list in increasing order.
+ @param l The list to sort.
+ @return The sorted list.
+ The values are gathered in a scratch array, sorted with a linear time radix sort and written back into the nodes of the list.
+ @note This function acts by side effect on the parameter l. The returned value is the same as the parameter l that is modified by the function.
+*/
+List* list_sort_increasing(List* l);
+
+/** Sort the list in decreasing order.
+ @param l The list to sort.
+ @return The sorted list.
+ @see list_sort_increasing
+ @note This function acts by side effect on the parameter l. The returned value is the same as the parameter l that is modified by the function.
+*/
+List* list_sort_decreasing(List* l);
+
+/** @}*/
+
+/*-----------------------------------------------------------------*/
+
+/** \defgroup ListIterator Bidirectional iterator on List.
+ Iterators give access to the elements of the list in sequence and allow to insert or remove elements at their position in O(1).
+ @{
+*/
+/** Define the direction the iterator walks on the list.
+*/
+typedef enum list_direction {BACKWARD_ITERATOR, FORWARD_ITERATOR} IteratorDirection;
+
+/** Opaque definition of type ListIterator.
+*/
+typedef struct s_ListIterator ListIterator;
+/** Définition of type ptrListIterator : pointer to a ListIterator.
+*/
+typedef ListIterator* ptrListIterator;
+
+/** Constructor : builds an iterator on the list l, going in the direction w, and put it at the beginning of the list.
+ 	@param l The list to iterate.
+ 	@param w The direction of the iterator (FORWARD_ITERATOR or BACKWARD_ITERATOR).
+ 	@return The correctly initialized iterator.
+*/
+ListIterator* list_iterator_create(List* l, IteratorDirection w);
+
+/** Destructor.
+ 	@param it the adress of the iterator.
+ 	After calling this function, the iterator it becomes NULL.
+*/
+void list_iterator_delete(ptrListIterator* it);
+
+/** Put the iterator at the beginning, with respect to its direction, of the list.
+ 	@return The modified iterator
+ 	@note This function acts by side effect on the parameter it. The returned value is the same as the parameter it that is modified by the function.
+*/
+ListIterator* list_iterator_begin(ListIterator* it);
+
+/** Test if the iterator is at the end, with respect to its direction, of the list.
+*/
+bool list_iterator_end(const ListIterator* it);
+
+/** Advance the iterator on the next element, with respect to its direction, of the list.
+ 	@return The modified iterator
+ 	@pre !list_iterator_end(it)
+ 	@note This function acts by side effect on the parameter it. The returned value is the same as the parameter it that is modified by the function.
+*/
+ListIterator* list_iterator_next(ListIterator* it);
+
+/** Acces to the element designated by the iterator.
+ 	@pre !list_iterator_end(it)
+*/
+int list_iterator_value(const ListIterator* it);
+
+/** Insert an element just before the element designated by the iterator, with respect to its direction.
+ 	@param it The iterator giving the position.
+ 	@param v The value to add.
+ 	@return The modified iterator, still designating the same element.
+ 	When the iterator is at the end, the element is added at the end, with respect to the direction of the iterator, of the list.
+ 	@note This function acts by side effect on the parameter it and on its list. The returned value is the same as the parameter it.
+*/
+ListIterator* list_iterator_insert(ListIterator* it, int v);
+
+/** Remove the element designated by the iterator and advance it to the next element.
+ 	@param it The iterator giving the position.
+ 	@return The modified iterator.
+ 	@pre !list_iterator_end(it)
+ 	@note This function acts by side effect on the parameter it and on its list. The returned value is the same as the parameter it.
+*/
+ListIterator* list_iterator_erase(ListIterator* it);
+
+/** Set the prefetching distance of the iterator.
+ 	@param it The iterator to modify.
+ 	@param distance The number of elements, ahead of the current one, that are requested to the memory system in advance. 0 disables prefetching.
+ 	@return The modified iterator.
+ 	With prefetching, the iterator follows the list with a second cursor running distance elements ahead of the current one,
+ 	so that the elements are loaded in cache before they are reached. This speeds up the traversal of lists whose elements are scattered in memory.
+ 	@note This function acts by side effect on the parameter it. The returned value is the same as the parameter it that is modified by the function.
+*/
+ListIterator* list_iterator_set_prefetch(ListIterator* it, int distance);
 /** @}*/
 
 /** @}*/
@@ -0,0 +1,263 @@
+/*-----------------------------------------------------------------*/
+/** \defgroup Bench list_bench
+ Benchmark of the operators of the abstract data type List.
+
+ \code{.unparsed}
+ $ ./list_bench [max_size]
+ \endcode
+ measures each operator on lists of 1e3, 1e4, ... up to max_size (default 1e8) elements and prints, in CSV format,
+ the mean time, the number of calls to malloc and free and the number of allocated bytes per operation.
+ For the constructors, the allocated bytes per operation are the bytes per element of the list.
+ Calls to malloc and free are counted by wrapping them at link time (see the Makefile).
+
+ \code{.unparsed}
+ $ ./list_bench -sort [size]
+ \endcode
+ compares the generic list_sort to the sort generated by LIST_DEFINE_SORT on size (default 1e7) random values.
+ As the generated sort is an array merge sort and list_sort a merge of the linked elements, the same array sort calling
+ its order through an OrderFunctor pointer is measured too : the gap between both array sorts is the gain of the inlined
+ comparison, the gap between list_sort and the array sort through a pointer is the gain of the algorithm and of the layout.
+ @{
+ */
+
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "list.h"
+#include "list_sort.h"
+
+/** \defgroup AllocationCounter Counter of the memory allocations.
+ The program is linked with <tt>-Wl,--wrap=malloc -Wl,--wrap=free</tt> : calls to malloc and free from the program and from list.c
+ are redirected to __wrap_malloc and __wrap_free, that count them before calling the actual allocator.
+ @{
+ */
+/** Counters of the allocator calls.
+ */
+typedef struct s_AllocationCounter {
+	long long mallocs;
+	long long frees;
+	long long bytes;
+} AllocationCounter;
+
+/** Allocator calls since the beginning of the program.
+ */
+AllocationCounter allocations = {0, 0, 0};
+
+void* __real_malloc(size_t size);
+void __real_free(void* ptr);
+
+/** Counting malloc.
+ */
+void* __wrap_malloc(size_t size) {
+	allocations.mallocs++;
+	allocations.bytes += size;
+	return __real_malloc(size);
+}
+
+/** Counting free.
+ */
+void __wrap_free(void* ptr) {
+	if (ptr != NULL)
+		allocations.frees++;
+	__real_free(ptr);
+}
+/** @} */
+
+/** Measure of an operation : start time and allocator counters at the beginning of the operation.
+ */
+typedef struct s_Measure {
+	double start;
+	AllocationCounter allocations;
+} Measure;
+
+/** Current time in seconds.
+ */
+double now(void) {
+	struct timespec t;
+	clock_gettime(CLOCK_MONOTONIC, &t);
+	return t.tv_sec + t.tv_nsec * 1e-9;
+}
+
+/** Start the measure of an operation.
+ */
+Measure measure_start(void) {
+	Measure m;
+	m.allocations = allocations;
+	m.start = now();
+	return m;
+}
+
+/** End the measure of an operation repeated nbops times on a list of given size and print it as a line of CSV.
+ */
+void measure_end(Measure m, const char* operation, int size, int nbops) {
+	double elapsed = now() - m.start;
+	printf("%s,%d,%d,%.2f,%.3f,%.3f,%.2f\n", operation, size, nbops, elapsed * 1e9 / nbops,
+		   (double)(allocations.mallocs - m.allocations.mallocs) / nbops,
+		   (double)(allocations.frees - m.allocations.frees) / nbops,
+		   (double)(allocations.bytes - m.allocations.bytes) / nbops);
+	fflush(stdout);
+}
+
+/** Operator used with list_map, leaving the elements unchanged.
+ */
+int identity(int v, void* env) {
+	(void)env;
+	return v;
+}
+
+/** Increasing order, called through a function pointer by list_sort.
+ */
+bool increasing(int a, int b) {
+	return a < b;
+}
+
+LIST_DEFINE_SORT(lt, a < b)
+
+/** Order called through a pointer by list_sort_through_pointer. The pointer is a global variable that may be modified by
+ another translation unit, so that the compiler cannot replace the call by the comparison.
+ */
+OrderFunctor order_pointer = increasing;
+
+LIST_DEFINE_SORT(through_pointer, order_pointer(a, b))
+
+/** Fill an array of n pseudo random values, the same ones for a given seed.
+ */
+int* random_values(int n, unsigned int seed) {
+	int* values = malloc(n * sizeof(int));
+	srand(seed);
+	for (int i = 0; i < n; ++i)
+		values[i] = rand();
+	return values;
+}
+
+/** Measure all the operators on lists of n elements.
+ */
+void bench_size(int n) {
+	int* values = random_values(n, n);
+	/* Positional operators are in O(n), only some of them are measured. */
+	int nbpositional = (n < 1000 ? n : 1000);
+
+	Measure m = measure_start();
+	List* l = list_create();
+	for (int i = 0; i < n; ++i)
+		list_push_back(l, values[i]);
+	measure_end(m, "push_back", n, n);
+
+	m = measure_start();
+	list_map(l, identity, NULL);
+	measure_end(m, "map", n, n);
+
+	m = measure_start();
+	list_sort(l, increasing);
+	measure_end(m, "sort", n, n);
+
+	m = measure_start();
+	while (!list_is_empty(l))
+		list_pop_back(l);
+	measure_end(m, "pop_back", n, n);
+
+	m = measure_start();
+	for (int i = 0; i < n; ++i)
+		list_push_front(l, values[i]);
+	measure_end(m, "push_front", n, n);
+
+	m = measure_start();
+	while (!list_is_empty(l))
+		list_pop_front(l);
+	measure_end(m, "pop_front", n, n);
+	list_delete(&l);
+
+	m = measure_start();
+	l = list_from_array(values, n);
+	measure_end(m, "from_array", n, n);
+
+	m = measure_start();
+	list_sort_lt(l);
+	measure_end(m, "sort_specialized", n, n);
+
+	m = measure_start();
+	list_sort(l, list_order_decreasing);
+	measure_end(m, "sort_radix", n, n);
+
+	m = measure_start();
+	for (int i = 0; i < nbpositional; ++i)
+		list_insert_at(l, values[i] % (list_size(l) + 1), i);
+	measure_end(m, "insert_at", n, nbpositional);
+
+	m = measure_start();
+	for (int i = 0; i < nbpositional; ++i)
+		list_remove_at(l, values[i] % list_size(l));
+	measure_end(m, "remove_at", n, nbpositional);
+
+	m = measure_start();
+	list_delete(&l);
+	measure_end(m, "delete_from_array", n, n);
+
+	l = list_create();
+	for (int i = 0; i < n; ++i)
+		list_push_back(l, values[i]);
+	m = measure_start();
+	list_delete(&l);
+	measure_end(m, "delete", n, n);
+
+	free(values);
+}
+
+/** Compare the generic merge sort, using an OrderFunctor, to the sort generated by LIST_DEFINE_SORT, with the order inlined
+ and with the order called through a pointer.
+ */
+void bench_sort(int n) {
+	int* values = random_values(n, 1);
+	List* generic = list_from_array(values, n);
+	List* pointer = list_from_array(values, n);
+	List* specialized = list_from_array(values, n);
+
+	double start = now();
+	list_sort(generic, increasing);
+	double generic_time = now() - start;
+
+	start = now();
+	list_sort_through_pointer(pointer);
+	double pointer_time = now() - start;
+
+	start = now();
+	list_sort_lt(specialized);
+	double specialized_time = now() - start;
+
+	int* g = list_to_array(generic, malloc(n * sizeof(int)));
+	int* p = list_to_array(pointer, malloc(n * sizeof(int)));
+	int* s = list_to_array(specialized, values);
+	int same = 1;
+	for (int i = 0; i < n && same; ++i)
+		same = (g[i] == s[i] && p[i] == s[i]);
+
+	printf("sort %d elements : %s results\n", n, (same ? "same" : "different"));
+	printf("\tlist_sort, list merge sort through a pointer : %.3f s\n", generic_time);
+	printf("\tarray merge sort through a pointer : %.3f s, speedup %.1f from the algorithm and layout\n", pointer_time,
+		   generic_time / pointer_time);
+	printf("\tarray merge sort inlined : %.3f s, speedup %.1f from the inlining\n", specialized_time, pointer_time / specialized_time);
+	free(g);
+	free(p);
+	free(values);
+	list_delete(&generic);
+	list_delete(&pointer);
+	list_delete(&specialized);
+}
+
+/** Main function of the benchmark.
+ */
+int main(int argc, char** argv){
+	if (argc > 1 && strcmp(argv[1], "-sort") == 0) {
+		bench_sort(argc > 2 ? atoi(argv[2]) : 10000000);
+		return 0;
+	}
+	int max_size = (argc > 1 ? atoi(argv[1]) : 100000000);
+	printf("operation,size,operations,ns_per_op,mallocs_per_op,frees_per_op,bytes_per_op\n");
+	for (long long n = 1000; n <= max_size; n *= 10)
+		bench_size((int)n);
+	return 0;
+}
+/** @} */
@@ -9,6 +9,12 @@
     - Implantation du TAD List étudié en cours.
 	- Représentation par liste doublement chainée avec sentinelle.
 	- Ajout d'un opérateur de tri (algorithme de tri fusion)
+	- Ajout d'un opérateur de réduction séquentiel et parallèle
+	- Tri par base (radix sort) pour les ordres croissant et décroissant
+	- Construction et export de listes par tableaux
+	- Déplacement de séquences d'éléments entre listes (concaténation, découpage)
+	- Itérateur bidirectionnel avec insertion, suppression et préchargement
+	- Génération de tris spécialisés pour un ordre connu à la compilation
  \subsection Resultats Resultats attendus
  \subsubsection Exercice1 Exercice 1
  \code{.unparsed}
@@ -80,6 +86,68 @@
  $
  \endcode
 
+ \subsubsection Exercice6 Exercice 6
+ \code{.unparsed}
+ $./list_test 6
+ -------- TEST REDUCE	--------
+ Sequential sum : 49950000
+ Parallel sum (1 threads) : 49950000
+ Parallel sum (2 threads) : 49950000
+ Parallel sum (4 threads) : 49950000
+ Parallel sum (8 threads) : 49950000
+ $
+ \endcode
+
+ \subsubsection Exercice7 Exercice 7
+ \code{.unparsed}
+ $./list_test 7
+ -------- TEST RADIX SORT	--------
+ Decreasing order : same as merge sort
+ Increasing order : same as merge sort
+ $
+ \endcode
+
+ \subsubsection Exercice8 Exercice 8
+ \code{.unparsed}
+ $./list_test 8
+ -------- TEST FROM_ARRAY	--------
+ List (10) : 0 1 2 3 4 5 6 7 8 9
+ -------- TEST APPEND_ARRAY	--------
+ List (13) : 1 2 3 4 6 7 8 9 0 1 2 3 42
+ -------- TEST TO_ARRAY	--------
+ Array (13) : 1 2 3 4 6 7 8 9 0 1 2 3 42
+ $
+ \endcode
+
+ \subsubsection Exercice9 Exercice 9
+ \code{.unparsed}
+ $./list_test 9
+ -------- TEST CONCAT	--------
+ List (10) : 0 1 2 3 4 5 6 7 8 9 - Other (0) :
+ -------- TEST SPLIT_AT	--------
+ List (6) : 0 1 2 3 4 5 - Other (4) : 6 7 8 9
+ -------- TEST SPLICE	--------
+ List (3) : 0 1 5 - Other (7) : 6 2 3 4 7 8 9
+ $
+ \endcode
+
+ \subsubsection Exercice10 Exercice 10
+ \code{.unparsed}
+ $./list_test 10
+ -------- TEST ITERATOR	--------
+ List (10) : 0 1 -3 3 5 -6 7 -9 9 10
+ Backward (10) : 10 9 -9 7 -6 5 3 -3 1 0
+ $
+ \endcode
+
+ \subsubsection Exercice11 Exercice 11
+ \code{.unparsed}
+ $./list_test 11
+ -------- TEST SPECIALIZED SORT	--------
+ Even first : List (8) : 4 6 2 5 3 1 3 7
+ $
+ \endcode
+
 */
 /*-----------------------------------------------------------------*/
 /** \defgroup Main main
@@ -91,6 +159,7 @@
 #include <stdlib.h>
 #include <assert.h>
 #include "list.h"
+#include "list_sort.h"
 
 /** \defgroup ListOperators Operators applied to the list.
 @{
@@ -106,9 +175,9 @@ int printList(int i, void* env){
 /** Operator to be used with list_reduce to compute the sum of the element of the list.
  @see ReduceFunctor
  */
-int accumulate(int v, void* acc) {
-	*((int*)acc)+=v;
-	return v;
+int accumulate(int acc, int v, void* env) {
+	(void)env;
+	return acc+v;
 }
 
 /** Operator to sort the list in increasing order with list_sort
@@ -125,6 +194,21 @@ bool gt(int i, int j) {
 	return i>j;
 }
 
+/** Test if two lists contain the same elements in the same order.
+ */
+bool same_elements(const List* l1, const List* l2) {
+	if (list_size(l1) != list_size(l2))
+		return false;
+	for (int i=0; i<list_size(l1); ++i)
+		if (list_at(l1, i) != list_at(l2, i))
+			return false;
+	return true;
+}
+
+/** Sort operator placing even values before odd values, generated by LIST_DEFINE_SORT.
+ */
+LIST_DEFINE_SORT(by_parity, a % 2 == 0 && b % 2 != 0)
+
 /** @} */
 
 /** \defgroup MainFunction Main function for testing.
@@ -163,9 +247,7 @@ int main(int argc, char** argv){
 			printf("List (%d) : ", list_size(l));
 			list_map(l, printList, stdout);
 			printf("\n");
-			int sum = 0;
-			list_map(l, accumulate, &sum);
-			printf("Sum is %d\n", sum);
+			printf("Sum is %d\n", list_reduce(l, accumulate, 0, NULL));
 		}
 		
 		if (num_exercice >= 3) {
@@ -220,7 +302,7 @@ int main(int argc, char** argv){
 
 			list_delete(&l);
 		}
-	} else {
+	} else if (num_exercice == 5) {
 		printf("-------- TEST SORT	--------\n");
 		List* l = list_create();
 		list_push_back(l, 5);
@@ -245,6 +327,128 @@ int main(int argc, char** argv){
 		list_map(l, printList, stdout);
 		printf("\n");
 
+		list_delete(&l);
+	} else if (num_exercice == 6) {
+		printf("-------- TEST REDUCE	--------\n");
+		List* l = list_create();
+		for (int i=0; i<100000 ;i++)
+			list_push_back(l, i%1000);
+		printf("Sequential sum : %d\n", list_reduce(l, accumulate, 0, NULL));
+		for (int t=1; t<=8 ; t*=2)
+			printf("Parallel sum (%d threads) : %d\n", t, list_parallel_reduce(l, accumulate, 0, NULL, t));
+		list_delete(&l);
+	} else if (num_exercice == 7) {
+		printf("-------- TEST RADIX SORT	--------\n");
+		List* l = list_create();
+		List* reference = list_create();
+		srand(num_exercice);
+		for (int i=0; i<10000 ;i++) {
+			int v = rand() - RAND_MAX/2;
+			list_push_back(l, v);
+			list_push_back(reference, v);
+		}
+		list_sort(reference, gt);
+		list_sort_decreasing(l);
+		printf("Decreasing order : %s\n", same_elements(l, reference) ? "same as merge sort" : "differs from merge sort");
+		list_sort(reference, lt);
+		list_sort(l, list_order_increasing);
+		printf("Increasing order : %s\n", same_elements(l, reference) ? "same as merge sort" : "differs from merge sort");
+		list_delete(&reference);
+		list_delete(&l);
+	} else if (num_exercice == 8) {
+		printf("-------- TEST FROM_ARRAY	--------\n");
+		int values[10];
+		for (int i=0; i<10 ;i++)
+			values[i] = i;
+		List* l = list_from_array(values, 10);
+		printf("List (%d) : ", list_size(l));
+		list_map(l, printList, stdout);
+		printf("\n");
+
+		printf("-------- TEST APPEND_ARRAY	--------\n");
+		list_append_array(l, values, 5);
+		list_pop_front(l);
+		list_pop_back(l);
+		list_remove_at(l, 4);
+		list_push_back(l, 42);
+		printf("List (%d) : ", list_size(l));
+		list_map(l, printList, stdout);
+		printf("\n");
+
+		printf("-------- TEST TO_ARRAY	--------\n");
+		int* content = list_to_array(l, malloc(list_size(l) * sizeof(int)));
+		printf("Array (%d) : ", list_size(l));
+		for (int i=0; i<list_size(l); ++i)
+			printf("%d ", content[i]);
+		printf("\n");
+		free(content);
+		list_delete(&l);
+	} else if (num_exercice == 9) {
+		printf("-------- TEST CONCAT	--------\n");
+		List* l = list_create();
+		List* other = list_create();
+		for (int i=0; i<10 ;i++)
+			list_push_back((i < 5 ? l : other), i);
+		list_concat(l, other);
+		printf("List (%d) : ", list_size(l));
+		list_map(l, printList, stdout);
+		printf("- Other (%d) : ", list_size(other));
+		list_map(other, printList, stdout);
+		printf("\n");
+
+		printf("-------- TEST SPLIT_AT	--------\n");
+		list_delete(&other);
+		other = list_split_at(l, 6);
+		printf("List (%d) : ", list_size(l));
+		list_map(l, printList, stdout);
+		printf("- Other (%d) : ", list_size(other));
+		list_map(other, printList, stdout);
+		printf("\n");
+
+		printf("-------- TEST SPLICE	--------\n");
+		list_splice(other, 1, l, 2, 3);
+		printf("List (%d) : ", list_size(l));
+		list_map(l, printList, stdout);
+		printf("- Other (%d) : ", list_size(other));
+		list_map(other, printList, stdout);
+		printf("\n");
+		list_delete(&other);
+		list_delete(&l);
+	} else if (num_exercice == 10) {
+		printf("-------- TEST ITERATOR	--------\n");
+		List* l = list_create();
+		for (int i=0; i<10 ;i++)
+			list_push_back(l, i);
+		ListIterator* it = list_iterator_create(l, FORWARD_ITERATOR);
+		for (it = list_iterator_begin(it); !list_iterator_end(it); ) {
+			if (list_iterator_value(it) % 3 == 0)
+				list_iterator_insert(it, -list_iterator_value(it));
+			if (list_iterator_value(it) % 2 == 0)
+				it = list_iterator_erase(it);
+			else
+				it = list_iterator_next(it);
+		}
+		list_iterator_insert(it, 10);
+		printf("List (%d) : ", list_size(l));
+		list_map(l, printList, stdout);
+		printf("\n");
+		list_iterator_delete(&it);
+
+		it = list_iterator_set_prefetch(list_iterator_create(l, BACKWARD_ITERATOR), 4);
+		printf("Backward (%d) : ", list_size(l));
+		for (it = list_iterator_begin(it); !list_iterator_end(it); it = list_iterator_next(it))
+			printf("%d ", list_iterator_value(it));
+		printf("\n");
+		list_iterator_delete(&it);
+		list_delete(&l);
+	} else {
+		printf("-------- TEST SPECIALIZED SORT	--------\n");
+		int values[8] = {5, 3, 4, 1, 6, 2, 3, 7};
+		List* l = list_from_array(values, 8);
+		list_sort_by_parity(l);
+		printf("Even first : List (%d) : ", list_size(l));
+		list_map(l, printList, stdout);
+		printf("\n");
 		list_delete(&l);
 	}
 	return 1;
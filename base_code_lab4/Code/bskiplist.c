@@ -0,0 +1,217 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#include "bskiplist.h"
+#include "rng.h"
+
+/* Alignment of the nodes : a cache line. */
+#define BNODE_ALIGNMENT 64
+
+/* A node of level l holds its values at the beginning of the node, followed by its l forward links. The nodes are aligned on
+   a cache line, so that the values fill exactly one line and are aligned for SIMD loads.
+   The unused slots hold INT_MAX so that the whole block may be compared. */
+typedef struct s_BNode {
+	int values[BSKIPLIST_NODE_VALUES];
+	int count;
+	int level;
+	struct s_BNode* forward[];
+} BNode;
+
+struct s_BSkipList {
+	BNode* sentinel;
+	int nblevels;
+	unsigned int size;
+	RNG rng;
+};
+
+BNode* bnode_create(int level) {
+	void* memory;
+	if (posix_memalign(&memory, BNODE_ALIGNMENT, sizeof(BNode) + level * sizeof(BNode*)) != 0)
+		return NULL;
+	BNode* n = memory;
+	for (int i = 0; i < BSKIPLIST_NODE_VALUES; i++)
+		n->values[i] = INT_MAX;
+	n->count = 0;
+	n->level = level;
+	return n;
+}
+
+/* Number of values of the node lower than value, that is the position of value in the node. */
+int bnode_lower_bound(const BNode* n, int value) {
+#ifdef __SSE2__
+	__m128i v = _mm_set1_epi32(value);
+	int mask = 0;
+	for (int i = 0; i < BSKIPLIST_NODE_VALUES; i += 4) {
+		__m128i block = _mm_load_si128((const __m128i*)(n->values + i));
+		mask |= _mm_movemask_ps(_mm_castsi128_ps(_mm_cmplt_epi32(block, v))) << i;
+	}
+#ifdef __GNUC__
+	return __builtin_popcount(mask);
+#else
+	int count = 0;
+	for (; mask != 0; mask &= mask - 1, count++);
+	return count;
+#endif
+#else
+	int count = 0;
+	for (int i = 0; i < BSKIPLIST_NODE_VALUES; i++)
+		count += (n->values[i] < value);
+	return count;
+#endif
+}
+
+BSkipList* bskiplist_create(int nblevels) {
+	if (nblevels > SKIPLIST_MAX_LEVELS)
+		nblevels = SKIPLIST_MAX_LEVELS;
+	BSkipList* d = malloc(sizeof(BSkipList));
+	d->sentinel = bnode_create(nblevels);
+	for (int i = 0; i < nblevels; i++)
+		d->sentinel->forward[i] = d->sentinel;
+	d->nblevels = nblevels;
+	d->size = 0;
+	d->rng = rng_initialize_geometric(0, nblevels, 1);
+	return d;
+}
+
+void bskiplist_delete(BSkipList** d) {
+	BNode* n = (*d)->sentinel->forward[0];
+	while (n != (*d)->sentinel) {
+		BNode* next = n->forward[0];
+		free(n);
+		n = next;
+	}
+	free((*d)->sentinel);
+	free(*d);
+	*d = NULL;
+}
+
+unsigned int bskiplist_size(const BSkipList* d) {
+	return d->size;
+}
+
+void bskiplist_map(const BSkipList* d, ScanOperator f, void *environment) {
+	for (BNode* n = d->sentinel->forward[0]; n != d->sentinel; n = n->forward[0])
+		for (int i = 0; i < n->count; i++)
+			f(n->values[i], environment);
+}
+
+/* Last node of each level whose lowest value is lower or equal to value, or lower than value if strict.
+   Returns the last one at level 0, the sentinel if value is lower than all the values of the list. */
+BNode* bskiplist_find(const BSkipList* d, int value, bool strict, BNode** update, unsigned int *nb_operations) {
+	BNode* cursor = d->sentinel;
+	for (int cur_l = d->nblevels-1; cur_l >= 0; cur_l--) {
+		BNode* next;
+		while ((next = cursor->forward[cur_l]) != d->sentinel && (next->values[0] < value || (!strict && next->values[0] == value))) {
+			cursor = next;
+			(*nb_operations)++;
+		}
+		if (update != NULL)
+			update[cur_l] = cursor;
+	}
+	return cursor;
+}
+
+/* Previous node of a node following n at a level l, given the update vector of a search that ended on n. */
+BNode* bskiplist_predecessor(BNode* n, BNode** update, int level) {
+	return (level < n->level ? n : update[level]);
+}
+
+/* Move the upper half of the full node n into a new node, linked after n. */
+BNode* bskiplist_split(BSkipList* d, BNode* n, BNode** update) {
+	BNode* new = bnode_create(rng_get_value(&(d->rng))+1);
+	int half = BSKIPLIST_NODE_VALUES / 2;
+	memcpy(new->values, n->values + half, (BSKIPLIST_NODE_VALUES - half) * sizeof(int));
+	new->count = BSKIPLIST_NODE_VALUES - half;
+	for (int i = half; i < BSKIPLIST_NODE_VALUES; i++)
+		n->values[i] = INT_MAX;
+	n->count = half;
+	for (int cur_l = 0; cur_l < new->level; cur_l++) {
+		BNode* pred = bskiplist_predecessor(n, update, cur_l);
+		new->forward[cur_l] = pred->forward[cur_l];
+		pred->forward[cur_l] = new;
+	}
+	return new;
+}
+
+/* Unlink and free the node following n at level 0. */
+void bskiplist_unlink_next(BNode* n, BNode** update) {
+	BNode* next = n->forward[0];
+	for (int cur_l = 0; cur_l < next->level; cur_l++)
+		bskiplist_predecessor(n, update, cur_l)->forward[cur_l] = next->forward[cur_l];
+	free(next);
+}
+
+BSkipList* bskiplist_insert(BSkipList* d, int value) {
+	BNode* update[SKIPLIST_MAX_LEVELS];
+	unsigned int nb_operations = 0;
+	BNode* target = bskiplist_find(d, value, false, update, &nb_operations);
+	if (target == d->sentinel) {
+		/* The value is lower than all the values of the list, it goes at the beginning of the first node. */
+		target = d->sentinel->forward[0];
+		if (target == d->sentinel) {
+			target = bnode_create(rng_get_value(&(d->rng))+1);
+			for (int cur_l = 0; cur_l < target->level; cur_l++) {
+				target->forward[cur_l] = d->sentinel->forward[cur_l];
+				d->sentinel->forward[cur_l] = target;
+			}
+		}
+	}
+	int position = bnode_lower_bound(target, value);
+	if (position < target->count && target->values[position] == value)
+		return d;
+	if (target->count == BSKIPLIST_NODE_VALUES) {
+		BNode* new = bskiplist_split(d, target, update);
+		if (position > target->count) {
+			position -= target->count;
+			target = new;
+		}
+	}
+	memmove(target->values + position + 1, target->values + position, (target->count - position) * sizeof(int));
+	target->values[position] = value;
+	target->count++;
+	d->size++;
+	return d;
+}
+
+BSkipList* bskiplist_remove(BSkipList* d, int value) {
+	BNode* update[SKIPLIST_MAX_LEVELS];
+	unsigned int nb_operations = 0;
+	BNode* target = bskiplist_find(d, value, false, update, &nb_operations);
+	if (target == d->sentinel)
+		return d;
+	int position = bnode_lower_bound(target, value);
+	if (position == target->count || target->values[position] != value)
+		return d;
+	d->size--;
+	if (target->count == 1) {
+		/* The node becomes empty : unlink it from its predecessors. */
+		BNode* pred = bskiplist_find(d, value, true, update, &nb_operations);
+		bskiplist_unlink_next(pred, update);
+		return d;
+	}
+	memmove(target->values + position, target->values + position + 1, (target->count - position - 1) * sizeof(int));
+	target->count--;
+	target->values[target->count] = INT_MAX;
+	/* Merge with the next node when both fit in three quarters of a node, so that a following insertion does not split them again. */
+	BNode* next = target->forward[0];
+	if (next != d->sentinel && target->count + next->count <= 3 * BSKIPLIST_NODE_VALUES / 4) {
+		memcpy(target->values + target->count, next->values, next->count * sizeof(int));
+		target->count += next->count;
+		bskiplist_unlink_next(target, update);
+	}
+	return d;
+}
+
+bool bskiplist_search(const BSkipList* d, int value, unsigned int *nb_operations) {
+	BNode* target = bskiplist_find(d, value, false, NULL, nb_operations);
+	if (target == d->sentinel)
+		return false;
+	int position = bnode_lower_bound(target, value);
+	return position < target->count && target->values[position] == value;
+}
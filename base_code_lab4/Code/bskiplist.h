@@ -0,0 +1,92 @@
+#ifndef __BSKIPLIST_H__
+#define __BSKIPLIST_H__
+#include <stdbool.h>
+
+#include "skiplist.h"
+
+/**
+ *	@defgroup BSkipListAT BSkipList abstract type
+ *  @brief Definition of a skip list whose nodes hold a sorted block of values.
+ *
+ *  Each node holds up to BSKIPLIST_NODE_VALUES values, in ascending order, and is linked according to its lowest value.
+ *  A search goes through the express lanes to the node whose range contains the value, then looks for the value in the
+ *  block, with SIMD comparisons when the compiler targets SSE2.
+ *  A full node is split in two when a value is inserted into it, and a node is merged with the next one when a removal
+ *  leaves both of them with less than a full block.
+ *
+ *  The operators are the ones of the SkipList abstract type.
+ *  @{
+ */
+
+/**
+ *	@brief Maximal number of values in a node.
+ */
+#define BSKIPLIST_NODE_VALUES 16
+
+/**
+ *	@brief Opaque definition of the BSkipList abstract data type.
+ */
+typedef struct s_BSkipList BSkipList;
+
+/**
+ *  @brief Constructor of an empty BSkipList.
+ *	@param nblevels the number of levels in the skip list, at most SKIPLIST_MAX_LEVELS.
+ *  @return a correctly initialized BSkipList.
+ *  @see skiplist_create
+ */
+BSkipList* bskiplist_create(int nblevels);
+
+/**
+ *  @brief Destructor of a BSkipList.
+ *	@param d the skiplist to delete.
+ */
+void bskiplist_delete(BSkipList** d);
+
+/**
+ *  @brief Access to the size the BSkipList.
+ *	@param d the skiplist to access
+ *  @return the number of elements in the skiplist.
+ */
+unsigned int bskiplist_size(const BSkipList* d);
+
+/**
+ *	@brief Insert a value in the skip list.
+ *	@param d the BSkipList to modify
+ *	@param value the value to insert
+ *  @return the eventually modified skiplist.
+ *	@note the parameter d is modified by side effect and is returned by the function
+ *  @see skiplist_insert
+ */
+BSkipList* bskiplist_insert(BSkipList* d, int value);
+
+/**
+ *	@brief Remove a value from the skip list.
+ *	@param d the BSkipList to remove from
+ *	@param value the value to remove
+ *  @return the eventually modified skiplist.
+ *	@note the parameter d is modified by side effect and is returned by the function
+ *  @see skiplist_remove
+ */
+BSkipList* bskiplist_remove(BSkipList* d, int value);
+
+/**
+ *  @brief Search for the presence of a value in a BSkipList.
+ *	@param d the BSkipList to search into
+ *	@param value the value to search for
+ *	@param nb_operations The number of tested nodes during the search
+ *  @return true if the value was found, false otherwise.
+ *  @see skiplist_search
+ */
+bool bskiplist_search(const BSkipList* d, int value, unsigned int *nb_operations);
+
+/**
+ *  @brief Apply an operator on each member of the BSkipList, from the begining to the end.
+ *	@param d the BSkipList to access
+ *	@param f the operator to apply
+ *	@param environment user supplied environment for calling the operator.
+ */
+void bskiplist_map(const BSkipList* d, ScanOperator f, void *environment);
+
+/** @} */
+
+#endif
@@ -0,0 +1,359 @@
+#include <stdlib.h>
+#include <stdint.h>
+#include <assert.h>
+
+#include "concurrent_skiplist.h"
+#include "rng.h"
+
+#define CONCURRENT_SKIPLIST_MAX_LEVELS 32
+
+/* Number of operations of a thread between two attempts to advance the global epoch. */
+#define EPOCH_PERIOD 64
+
+/* Links are stored as integers whose lowest bit marks the node owning the link as removed. */
+typedef uintptr_t Link;
+
+/* Life cycle of a node with respect to its insertion. */
+typedef enum e_NodeState {LINKING, LINKED, REMOVED_WHILE_LINKING} NodeState;
+
+typedef struct s_Node {
+	int value;
+	int level;
+	int state;
+	struct s_Node* retired_next;
+	Link next[];
+} Node;
+
+/* Nodes retired by a thread while its local epoch was epoch. */
+typedef struct s_RetiredBin {
+	unsigned long epoch;
+	Node* nodes;
+} RetiredBin;
+
+struct s_ConcurrentSkipListThread {
+	ConcurrentSkipList* skiplist;
+	RNG rng;
+	unsigned long epoch;
+	int active;
+	int in_use;
+	unsigned int operations;
+	RetiredBin retired[3];
+	struct s_ConcurrentSkipListThread* next;
+};
+
+struct s_ConcurrentSkipList {
+	Node* head;
+	Node* tail;
+	int nblevels;
+	unsigned int size;
+	unsigned long epoch;
+	ConcurrentSkipListThread* threads;
+};
+
+/*---------------------------------------------------------------------------------------------------------------------*/
+/* Marked links.                                                                                                       */
+
+Node* link_node(Link l) {
+	return (Node*)(l & ~(Link)1);
+}
+
+bool link_marked(Link l) {
+	return (l & 1) != 0;
+}
+
+Link link_make(Node* n, bool marked) {
+	return (Link)n | (marked ? 1 : 0);
+}
+
+Link link_load(Node* n, int level) {
+	return __atomic_load_n(&(n->next[level]), __ATOMIC_SEQ_CST);
+}
+
+bool link_cas(Node* n, int level, Link expected, Link desired) {
+	return __atomic_compare_exchange_n(&(n->next[level]), &expected, desired, false, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+}
+
+Node* node_create(int value, int level) {
+	Node* n = malloc(sizeof(Node) + level * sizeof(Link));
+	n->value = value;
+	n->level = level;
+	n->state = LINKING;
+	n->retired_next = NULL;
+	return n;
+}
+
+/*---------------------------------------------------------------------------------------------------------------------*/
+/* Epoch based reclamation.                                                                                            */
+/* A thread announces the global epoch when it starts an operation. The global epoch moves forward once every active    */
+/* thread has announced it. A node retired when the global epoch is e is unreachable for operations started after its */
+/* retirement, so it is freed once the global epoch reaches e + 2 : the operations that may have reached it are then   */
+/* completed.                                                                                                          */
+
+void epoch_release_bins(ConcurrentSkipListThread* t, unsigned long global) {
+	for (int i = 0; i < 3; ++i)
+		if (t->retired[i].nodes != NULL && t->retired[i].epoch + 2 <= global) {
+			Node* n = t->retired[i].nodes;
+			while (n != NULL) {
+				Node* next = n->retired_next;
+				free(n);
+				n = next;
+			}
+			t->retired[i].nodes = NULL;
+		}
+}
+
+void epoch_try_advance(ConcurrentSkipList* d, unsigned long global) {
+	for (ConcurrentSkipListThread* t = __atomic_load_n(&(d->threads), __ATOMIC_SEQ_CST); t != NULL; t = t->next)
+		if (__atomic_load_n(&(t->active), __ATOMIC_SEQ_CST) && __atomic_load_n(&(t->epoch), __ATOMIC_SEQ_CST) != global)
+			return;
+	__atomic_compare_exchange_n(&(d->epoch), &global, global + 1, false, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+}
+
+void epoch_enter(ConcurrentSkipListThread* t) {
+	ConcurrentSkipList* d = t->skiplist;
+	__atomic_store_n(&(t->active), 1, __ATOMIC_SEQ_CST);
+	unsigned long global = __atomic_load_n(&(d->epoch), __ATOMIC_SEQ_CST);
+	__atomic_store_n(&(t->epoch), global, __ATOMIC_SEQ_CST);
+	if (++(t->operations) % EPOCH_PERIOD == 0) {
+		epoch_try_advance(d, global);
+		epoch_release_bins(t, __atomic_load_n(&(d->epoch), __ATOMIC_SEQ_CST));
+	}
+}
+
+void epoch_exit(ConcurrentSkipListThread* t) {
+	__atomic_store_n(&(t->active), 0, __ATOMIC_SEQ_CST);
+}
+
+void epoch_retire(ConcurrentSkipListThread* t, Node* n) {
+	/* The node is tagged with the global epoch read after it was unlinked, and not with the epoch of the thread :
+	   a thread may have reached the node in this epoch before it was unlinked. */
+	unsigned long global = __atomic_load_n(&(t->skiplist->epoch), __ATOMIC_SEQ_CST);
+	RetiredBin* bin = &(t->retired[global % 3]);
+	if (bin->nodes != NULL && bin->epoch != global) {
+		/* The bin holds nodes retired three epochs ago or more, they can be freed. */
+		epoch_release_bins(t, global);
+	}
+	bin->epoch = global;
+	n->retired_next = bin->nodes;
+	bin->nodes = n;
+}
+
+/*---------------------------------------------------------------------------------------------------------------------*/
+/* Construction and destruction.                                                                                       */
+
+ConcurrentSkipList* concurrent_skiplist_create(int nblevels) {
+	if (nblevels > CONCURRENT_SKIPLIST_MAX_LEVELS)
+		nblevels = CONCURRENT_SKIPLIST_MAX_LEVELS;
+	ConcurrentSkipList* d = malloc(sizeof(ConcurrentSkipList));
+	d->head = node_create(0, nblevels);
+	d->tail = node_create(0, nblevels);
+	for (int i = 0; i < nblevels; ++i) {
+		d->head->next[i] = link_make(d->tail, false);
+		d->tail->next[i] = link_make(NULL, false);
+	}
+	d->nblevels = nblevels;
+	d->size = 0;
+	d->epoch = 0;
+	d->threads = NULL;
+	return d;
+}
+
+void concurrent_skiplist_delete(ConcurrentSkipList** d) {
+	ConcurrentSkipListThread* t = (*d)->threads;
+	while (t != NULL) {
+		ConcurrentSkipListThread* next = t->next;
+		epoch_release_bins(t, (unsigned long)-1);
+		free(t);
+		t = next;
+	}
+	Node* n = link_node((*d)->head->next[0]);
+	while (n != (*d)->tail) {
+		Node* next = link_node(n->next[0]);
+		free(n);
+		n = next;
+	}
+	free((*d)->head);
+	free((*d)->tail);
+	free(*d);
+	*d = NULL;
+}
+
+ConcurrentSkipListThread* concurrent_skiplist_register(ConcurrentSkipList* d, unsigned long long seed) {
+	ConcurrentSkipListThread* t;
+	for (t = __atomic_load_n(&(d->threads), __ATOMIC_SEQ_CST); t != NULL; t = t->next) {
+		int unused = 0;
+		if (__atomic_compare_exchange_n(&(t->in_use), &unused, 1, false, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST))
+			break;
+	}
+	if (t == NULL) {
+		t = malloc(sizeof(ConcurrentSkipListThread));
+		t->skiplist = d;
+		t->epoch = 0;
+		t->active = 0;
+		t->in_use = 1;
+		t->operations = 0;
+		for (int i = 0; i < 3; ++i) {
+			t->retired[i].epoch = 0;
+			t->retired[i].nodes = NULL;
+		}
+		t->next = __atomic_load_n(&(d->threads), __ATOMIC_SEQ_CST);
+		while (!__atomic_compare_exchange_n(&(d->threads), &(t->next), t, false, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST));
+	}
+	t->rng = rng_initialize_geometric(seed, d->nblevels, 1);
+	return t;
+}
+
+void concurrent_skiplist_unregister(ConcurrentSkipListThread* t) {
+	__atomic_store_n(&(t->active), 0, __ATOMIC_SEQ_CST);
+	__atomic_store_n(&(t->in_use), 0, __ATOMIC_SEQ_CST);
+}
+
+unsigned int concurrent_skiplist_size(const ConcurrentSkipList* d) {
+	return __atomic_load_n(&(d->size), __ATOMIC_SEQ_CST);
+}
+
+/*---------------------------------------------------------------------------------------------------------------------*/
+/* Operators.                                                                                                          */
+
+/* Find, at each level, the last node whose value is lower than value and its successor, unlinking the marked nodes met
+   on the way. Returns true if the successor at level 0 holds value. */
+bool concurrent_skiplist_find(ConcurrentSkipList* d, int value, Node** preds, Node** succs) {
+retry:
+	{
+		Node* pred = d->head;
+		for (int level = d->nblevels - 1; level >= 0; --level) {
+			Node* curr = link_node(link_load(pred, level));
+			for (;;) {
+				if (curr == d->tail)
+					break;
+				Link succ = link_load(curr, level);
+				while (link_marked(succ)) {
+					if (!link_cas(pred, level, link_make(curr, false), link_make(link_node(succ), false)))
+						goto retry;
+					curr = link_node(succ);
+					if (curr == d->tail)
+						break;
+					succ = link_load(curr, level);
+				}
+				if (curr == d->tail || curr->value >= value)
+					break;
+				pred = curr;
+				curr = link_node(succ);
+			}
+			preds[level] = pred;
+			succs[level] = curr;
+		}
+		return succs[0] != d->tail && succs[0]->value == value;
+	}
+}
+
+bool concurrent_skiplist_insert(ConcurrentSkipList* d, ConcurrentSkipListThread* t, int value) {
+	Node* preds[CONCURRENT_SKIPLIST_MAX_LEVELS];
+	Node* succs[CONCURRENT_SKIPLIST_MAX_LEVELS];
+	int level = rng_get_value(&(t->rng)) + 1;
+	Node* n = node_create(value, level);
+	epoch_enter(t);
+	for (;;) {
+		if (concurrent_skiplist_find(d, value, preds, succs)) {
+			epoch_exit(t);
+			free(n);
+			return false;
+		}
+		for (int i = 0; i < level; ++i)
+			n->next[i] = link_make(succs[i], false);
+		if (link_cas(preds[0], 0, link_make(succs[0], false), link_make(n, false)))
+			break;
+	}
+	__atomic_add_fetch(&(d->size), 1, __ATOMIC_SEQ_CST);
+
+	for (int i = 1; i < level; ++i) {
+		for (;;) {
+			Link next = link_load(n, i);
+			if (link_marked(next))
+				goto linked;
+			if (link_node(next) != succs[i] && !link_cas(n, i, next, link_make(succs[i], false)))
+				continue;
+			if (link_cas(preds[i], i, link_make(succs[i], false), link_make(n, false)))
+				break;
+			if (!concurrent_skiplist_find(d, value, preds, succs) || succs[0] != n)
+				goto linked;
+		}
+	}
+linked:
+	{
+		/* A removal may have started while the node was being linked at the upper levels, and the node may have been linked
+		   at some level after the remover unlinked it. This thread then unlinks it again before leaving it to the remover,
+		   or retires it itself if the remover has already left. */
+		if (link_marked(link_load(n, 0)))
+			concurrent_skiplist_find(d, value, preds, succs);
+		int state = LINKING;
+		if (!__atomic_compare_exchange_n(&(n->state), &state, LINKED, false, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST)) {
+			concurrent_skiplist_find(d, value, preds, succs);
+			epoch_retire(t, n);
+		}
+	}
+	epoch_exit(t);
+	return true;
+}
+
+bool concurrent_skiplist_remove(ConcurrentSkipList* d, ConcurrentSkipListThread* t, int value) {
+	Node* preds[CONCURRENT_SKIPLIST_MAX_LEVELS];
+	Node* succs[CONCURRENT_SKIPLIST_MAX_LEVELS];
+	epoch_enter(t);
+	if (!concurrent_skiplist_find(d, value, preds, succs)) {
+		epoch_exit(t);
+		return false;
+	}
+	Node* n = succs[0];
+	for (int i = n->level - 1; i > 0; --i) {
+		Link next = link_load(n, i);
+		while (!link_marked(next)) {
+			link_cas(n, i, next, link_make(link_node(next), true));
+			next = link_load(n, i);
+		}
+	}
+	for (;;) {
+		Link next = link_load(n, 0);
+		if (link_marked(next)) {
+			/* Removed by another thread. */
+			epoch_exit(t);
+			return false;
+		}
+		if (link_cas(n, 0, next, link_make(link_node(next), true)))
+			break;
+	}
+	__atomic_sub_fetch(&(d->size), 1, __ATOMIC_SEQ_CST);
+	concurrent_skiplist_find(d, value, preds, succs);
+	int state = LINKING;
+	if (!__atomic_compare_exchange_n(&(n->state), &state, REMOVED_WHILE_LINKING, false, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST))
+		epoch_retire(t, n);
+	epoch_exit(t);
+	return true;
+}
+
+bool concurrent_skiplist_search(ConcurrentSkipList* d, ConcurrentSkipListThread* t, int value) {
+	epoch_enter(t);
+	Node* pred = d->head;
+	Node* curr = NULL;
+	for (int level = d->nblevels - 1; level >= 0; --level) {
+		curr = link_node(link_load(pred, level));
+		for (;;) {
+			if (curr == d->tail)
+				break;
+			Link succ = link_load(curr, level);
+			while (link_marked(succ)) {
+				curr = link_node(succ);
+				if (curr == d->tail)
+					break;
+				succ = link_load(curr, level);
+			}
+			if (curr == d->tail || curr->value >= value)
+				break;
+			pred = curr;
+			curr = link_node(succ);
+		}
+	}
+	bool found = (curr != d->tail && curr->value == value);
+	epoch_exit(t);
+	return found;
+}
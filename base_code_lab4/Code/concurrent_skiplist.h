@@ -0,0 +1,94 @@
+#ifndef __CONCURRENT_SKIPLIST_H__
+#define __CONCURRENT_SKIPLIST_H__
+#include <stdbool.h>
+
+/**
+ *	@defgroup ConcurrentSkipListAT Concurrent SkipList
+ *  @brief Definition of a lock-free SkipList supporting concurrent insertion, removal and search.
+ *
+ *  Links are updated with compare-and-swap operations. A node is first logically removed by marking its links,
+ *  then physically unlinked by any thread going through it. Removed nodes are released through an epoch based
+ *  reclamation scheme : a node is freed once every thread that could have reached it has completed its operation.
+ *
+ *  Each thread working on a ConcurrentSkipList must register to get a ConcurrentSkipListThread, holding its own
+ *  random number generator and its reclamation state, and give it to each operator.
+ *  @{
+ */
+
+/**
+ *	@brief Opaque definition of the ConcurrentSkipList abstract data type.
+ */
+typedef struct s_ConcurrentSkipList ConcurrentSkipList;
+
+/**
+ *	@brief Opaque definition of the per thread state used to access a ConcurrentSkipList.
+ */
+typedef struct s_ConcurrentSkipListThread ConcurrentSkipListThread;
+
+/**
+ *  @brief Constructor of an empty ConcurrentSkipList.
+ *	@param nblevels the number of levels in the skip list, at most 32.
+ *  @return a correctly initialized ConcurrentSkipList.
+ */
+ConcurrentSkipList* concurrent_skiplist_create(int nblevels);
+
+/**
+ *  @brief Destructor of a ConcurrentSkipList.
+ *	@param d the skiplist to delete.
+ *  @pre No thread uses the skiplist anymore.
+ */
+void concurrent_skiplist_delete(ConcurrentSkipList** d);
+
+/**
+ *  @brief Register the calling thread to access the skiplist.
+ *	@param d the skiplist to access.
+ *	@param seed the seed of the random number generator of the thread.
+ *  @return the state of the thread, to give to each operator called by this thread.
+ */
+ConcurrentSkipListThread* concurrent_skiplist_register(ConcurrentSkipList* d, unsigned long long seed);
+
+/**
+ *  @brief Unregister a thread.
+ *	@param t the state of the thread, that can not be used anymore.
+ *  @note The nodes removed by the thread that can not be freed yet are released by concurrent_skiplist_delete.
+ */
+void concurrent_skiplist_unregister(ConcurrentSkipListThread* t);
+
+/**
+ *  @brief Access to the size the ConcurrentSkipList.
+ *	@param d the skiplist to access.
+ *  @return the number of elements in the skiplist.
+ *  @note When other threads modify the skiplist, the result may be outdated as soon as it is returned.
+ */
+unsigned int concurrent_skiplist_size(const ConcurrentSkipList* d);
+
+/**
+ *	@brief Insert a value in the skiplist.
+ *	@param d the skiplist to modify.
+ *	@param t the state of the calling thread.
+ *	@param value the value to insert.
+ *  @return true if the value was inserted, false if it was already present.
+ */
+bool concurrent_skiplist_insert(ConcurrentSkipList* d, ConcurrentSkipListThread* t, int value);
+
+/**
+ *	@brief Remove a value from the skiplist.
+ *	@param d the skiplist to modify.
+ *	@param t the state of the calling thread.
+ *	@param value the value to remove.
+ *  @return true if the value was removed by this call, false if it was not present.
+ */
+bool concurrent_skiplist_remove(ConcurrentSkipList* d, ConcurrentSkipListThread* t, int value);
+
+/**
+ *	@brief Search for the presence of a value in the skiplist.
+ *	@param d the skiplist to search into.
+ *	@param t the state of the calling thread.
+ *	@param value the value to search for.
+ *  @return true if the value was found, false otherwise.
+ */
+bool concurrent_skiplist_search(ConcurrentSkipList* d, ConcurrentSkipListThread* t, int value);
+
+/** @} */
+
+#endif
@@ -0,0 +1,263 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+
+#include "concurrent_skiplist.h"
+
+/**
+ *	@defgroup ConcurrentSkipListTest Test program for the ConcurrentSkipList Implantation
+ *  @brief Correctness test and throughput benchmark of the lock-free skiplist.
+ *  @{
+ */
+
+/** Number of operations done by each thread for a throughput measure.
+ */
+#define NB_OPERATIONS 1000000
+
+/** Print a usage message for this program.
+
+ @code{.unparsed}
+ $concurrent_skiplisttest num [max_threads]
+ 	Construct concurrently the skiplist with data read from file ../Test/test_files/construct_num.txt, check its content,
+ 	then remove concurrently all its values.
+ 	Then measure the throughput of 1, 2, 4 ... up to max_threads (default 8) threads doing a mix of searches, insertions
+ 	and removals of the values read from file ../Test/test_files/search_num.txt, for several ratios of searches.
+ @endcode
+ */
+void usage(const char *command) {
+	printf("usage : %s num [max_threads]\n", command);
+	printf("\tConstruct concurrently the skiplist with data read from file test_files/construct_num.txt, check its content, then remove concurrently all its values.\n");
+	printf("\tThen measure the throughput of 1, 2, 4 ... up to max_threads (default 8) threads doing a mix of searches, insertions and removals of the values read from file test_files/search_num.txt\n");
+}
+
+/** Return the filename associated with the action to perform and the number of a test.
+ @see gettestfilename in skiplisttest.c
+ */
+char *gettestfilename(const char *action, int numtest) {
+	const char *testdir ="../Test/test_files/";
+	int l = strlen(testdir) + strlen(action) + strlen("_xxx.txt");
+	char *name = malloc(l*sizeof(char));
+	sprintf(name, "%s%s_%d.txt", testdir, action, numtest);
+	return name;
+}
+
+unsigned int read_uint(FILE* input) {
+  unsigned int v;
+  int r = fscanf(input,"%u", &v);
+  if (r == 1) {
+    return v;
+  }
+  perror("Unable to read uint from input file\n");
+  abort();
+}
+
+/** Values read from a test file.
+ */
+typedef struct s_TestValues {
+	int nblevels;
+	unsigned int nb_values;
+	int* values;
+} TestValues;
+
+/** Read the values of a test file.
+ @param action "construct", whose file starts with the number of levels, or "search".
+ */
+TestValues read_values(const char* action, int num) {
+	TestValues v = {0, 0, NULL};
+	char *filename = gettestfilename(action, num);
+	FILE *input = fopen(filename, "r");
+	if (input == NULL) {
+		printf("Unable to open file %s\n", filename);
+		free(filename);
+		exit (1);
+	}
+	if (strcmp(action, "construct") == 0)
+		v.nblevels = read_uint(input);
+	v.nb_values = read_uint(input);
+	v.values = malloc(v.nb_values * sizeof(int));
+	for (unsigned int i=0; i < v.nb_values; ++i)
+		v.values[i] = (int)read_uint(input);
+	free(filename);
+	fclose(input);
+	return v;
+}
+
+/*----------------------------------------------------------------------------------------------*/
+
+/** Work of a test thread.
+ */
+typedef struct s_ThreadData {
+	ConcurrentSkipList* skiplist;
+	const TestValues* values;
+	int rank;
+	int nbthreads;
+	int read_ratio;
+	unsigned int succeeded;
+	pthread_t thread;
+} ThreadData;
+
+/** Insert the values of rank rank modulo nbthreads, counting the successful insertions.
+ */
+void* insert_values(void* arg) {
+	ThreadData* data = (ThreadData*)arg;
+	ConcurrentSkipListThread* t = concurrent_skiplist_register(data->skiplist, data->rank);
+	for (unsigned int i = data->rank; i < data->values->nb_values; i += data->nbthreads)
+		data->succeeded += concurrent_skiplist_insert(data->skiplist, t, data->values->values[i]);
+	concurrent_skiplist_unregister(t);
+	return NULL;
+}
+
+/** Remove all the values, each thread starting at a different position, counting the successful removals.
+ */
+void* remove_values(void* arg) {
+	ThreadData* data = (ThreadData*)arg;
+	ConcurrentSkipListThread* t = concurrent_skiplist_register(data->skiplist, data->rank);
+	unsigned int n = data->values->nb_values;
+	for (unsigned int i = 0; i < n; ++i)
+		data->succeeded += concurrent_skiplist_remove(data->skiplist, t, data->values->values[(i + data->rank * (n / data->nbthreads)) % n]);
+	concurrent_skiplist_unregister(t);
+	return NULL;
+}
+
+/** Do NB_OPERATIONS operations on the values : searches with probability read_ratio percent, otherwise alternatively
+ insertions and removals.
+ */
+void* mixed_operations(void* arg) {
+	ThreadData* data = (ThreadData*)arg;
+	ConcurrentSkipListThread* t = concurrent_skiplist_register(data->skiplist, data->rank);
+	unsigned int n = data->values->nb_values;
+	unsigned long long random = data->rank + 1;
+	bool insert = true;
+	for (int i = 0; i < NB_OPERATIONS; ++i) {
+		random = random * 6364136223846793005ULL + 1442695040888963407ULL;
+		int value = data->values->values[(random >> 33) % n];
+		if ((int)((random >> 16) % 100) < data->read_ratio)
+			data->succeeded += concurrent_skiplist_search(data->skiplist, t, value);
+		else {
+			data->succeeded += (insert ? concurrent_skiplist_insert(data->skiplist, t, value) : concurrent_skiplist_remove(data->skiplist, t, value));
+			insert = !insert;
+		}
+	}
+	concurrent_skiplist_unregister(t);
+	return NULL;
+}
+
+/** Run nbthreads threads executing work and return the total number of successful operations.
+ */
+unsigned int run_threads(void* (*work)(void*), ConcurrentSkipList* d, const TestValues* values, int nbthreads, int read_ratio) {
+	ThreadData* threads = calloc(nbthreads, sizeof(ThreadData));
+	for (int i = 0; i < nbthreads; ++i) {
+		threads[i].skiplist = d;
+		threads[i].values = values;
+		threads[i].rank = i;
+		threads[i].nbthreads = nbthreads;
+		threads[i].read_ratio = read_ratio;
+		pthread_create(&(threads[i].thread), NULL, work, &threads[i]);
+	}
+	unsigned int succeeded = 0;
+	for (int i = 0; i < nbthreads; ++i) {
+		pthread_join(threads[i].thread, NULL);
+		succeeded += threads[i].succeeded;
+	}
+	free(threads);
+	return succeeded;
+}
+
+int compare_int(const void* a, const void* b) {
+	int x = *(const int*)a, y = *(const int*)b;
+	return (x > y) - (x < y);
+}
+
+/** Number of distinct values in an array.
+ */
+unsigned int count_distinct(const TestValues* values) {
+	int* sorted = malloc(values->nb_values * sizeof(int));
+	memcpy(sorted, values->values, values->nb_values * sizeof(int));
+	qsort(sorted, values->nb_values, sizeof(int), compare_int);
+	unsigned int distinct = 0;
+	for (unsigned int i = 0; i < values->nb_values; ++i)
+		distinct += (i == 0 || sorted[i] != sorted[i-1]);
+	free(sorted);
+	return distinct;
+}
+
+/** Current time in seconds.
+ */
+double now(void) {
+	struct timespec t;
+	clock_gettime(CLOCK_MONOTONIC, &t);
+	return t.tv_sec + t.tv_nsec * 1e-9;
+}
+
+/** Concurrent construction, check and destruction of the skiplist.
+ @return true if the skiplist held the expected values.
+ */
+bool test_concurrent(const TestValues* construct, int nbthreads) {
+	ConcurrentSkipList* d = concurrent_skiplist_create(construct->nblevels);
+	unsigned int distinct = count_distinct(construct);
+	unsigned int inserted = run_threads(insert_values, d, construct, nbthreads, 0);
+
+	ConcurrentSkipListThread* t = concurrent_skiplist_register(d, 0);
+	unsigned int found = 0;
+	for (unsigned int i = 0; i < construct->nb_values; ++i)
+		found += concurrent_skiplist_search(d, t, construct->values[i]);
+	concurrent_skiplist_unregister(t);
+	printf("%d threads : %u values inserted, size %u, %u/%u values found\n", nbthreads, inserted, concurrent_skiplist_size(d),
+		   found, construct->nb_values);
+	bool ok = (inserted == distinct && concurrent_skiplist_size(d) == distinct && found == construct->nb_values);
+
+	unsigned int removed = run_threads(remove_values, d, construct, nbthreads, 0);
+	printf("%d threads : %u values removed, size %u\n", nbthreads, removed, concurrent_skiplist_size(d));
+	ok = ok && removed == distinct && concurrent_skiplist_size(d) == 0;
+	concurrent_skiplist_delete(&d);
+	return ok;
+}
+
+/** Throughput of nbthreads threads doing mixed operations on the skiplist built from construct.
+ */
+void test_throughput(const TestValues* construct, const TestValues* search, int nbthreads, int read_ratio) {
+	ConcurrentSkipList* d = concurrent_skiplist_create(construct->nblevels);
+	run_threads(insert_values, d, construct, 1, 0);
+	double start = now();
+	run_threads(mixed_operations, d, search, nbthreads, read_ratio);
+	double elapsed = now() - start;
+	printf("%7d %9d%% %12.2f\n", nbthreads, read_ratio, (double)nbthreads * NB_OPERATIONS / elapsed * 1e-6);
+	concurrent_skiplist_delete(&d);
+}
+
+int main(int argc, const char *argv[]){
+	if (argc < 2) {
+		usage(argv[0]);
+		return 1;
+	}
+	int num = atoi(argv[1]);
+	int max_threads = (argc > 2 ? atoi(argv[2]) : 8);
+	if (max_threads < 1) {
+		usage(argv[0]);
+		return 1;
+	}
+	TestValues construct = read_values("construct", num);
+	TestValues search = read_values("search", num);
+
+	printf("-------- TEST CONCURRENT --------\n");
+	bool ok = true;
+	for (int nbthreads = 1; nbthreads <= max_threads; nbthreads *= 2)
+		ok = test_concurrent(&construct, nbthreads) && ok;
+
+	printf("-------- THROUGHPUT --------\n");
+	printf("threads  searches  Mops/s\n");
+	const int read_ratios[] = {100, 90, 50};
+	for (int nbthreads = 1; nbthreads <= max_threads; nbthreads *= 2)
+		for (unsigned int r = 0; r < sizeof(read_ratios) / sizeof(read_ratios[0]); ++r)
+			test_throughput(&construct, &search, nbthreads, read_ratios[r]);
+
+	free(construct.values);
+	free(search.values);
+	return (ok ? 0 : 1);
+}
+
+/** @} */
@@ -7,23 +7,52 @@ const unsigned long long int rng_c = 0xb;
 const unsigned long long int rng_m = 0x1000000000000;
 
 unsigned long long int next_val(unsigned long long int r_n) {
-	return (rng_a * r_n + rng_c) % rng_m;
+	return (rng_a * r_n + rng_c) & (rng_m - 1);
 }
 
-unsigned long int toss(unsigned short *seed) {
-	unsigned long long int rn = seed[0] + ((unsigned long long int)seed[1] << 16) + ((unsigned long long int)seed[2] << 32);
-	rn = next_val(rn);
-	seed[0] = (unsigned short) (rn);
-	seed[1] = (unsigned short) (rn>>16);
-	seed[2] = (unsigned short) (rn>>32);
-	return (rn >> 17) & MAX_RN;
+/* The 48 bits state of the linear congruential generator is kept in a single integer instead of three unsigned short. */
+unsigned long int toss(unsigned long long int *seed) {
+	*seed = next_val(*seed);
+	return (*seed >> 17) & MAX_RN;
+}
+
+/* splitmix64 generator, by Sebastiano Vigna : a 64 bits state and a single multiply-xorshift mixing per draw. */
+unsigned long long int splitmix_next(unsigned long long int *x) {
+	unsigned long long int z = (*x += 0x9e3779b97f4a7c15ULL);
+	z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+	z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+	return z ^ (z >> 31);
+}
+
+unsigned int count_trailing_zeros(unsigned long long int x) {
+	if (x == 0)
+		return 64;
+#ifdef __GNUC__
+	return __builtin_ctzll(x);
+#else
+	unsigned int n = 0;
+	for (; (x & 1) == 0; x >>= 1, ++n);
+	return n;
+#endif
 }
 
 RNG rng_initialize(unsigned long long int s, unsigned int max_value){
 	RNG rng;
-	rng.xsubi[0] = (unsigned short) (s);
-	rng.xsubi[1] = (unsigned short) (s>>16);
-	rng.xsubi[2] = (unsigned short) (s>>32);
+	rng.algorithm = RNG_LCG48;
+	rng.state = s & (rng_m - 1);
+	rng.log2_inverse_p = 1;
+	rng.reciprocal = 65536;
+	rng.max_value = max_value-1;
+	return rng;
+}
+
+RNG rng_initialize_geometric(unsigned long long int s, unsigned int max_value, unsigned int log2_inverse_p){
+	RNG rng;
+	rng.algorithm = RNG_SPLITMIX64;
+	rng.state = s;
+	rng.log2_inverse_p = (log2_inverse_p == 0 ? 1 : log2_inverse_p);
+	/* floor(z / log2_inverse_p) = (z * ceil(2^16 / log2_inverse_p)) >> 16 for the numbers z of trailing zeros, at most 64. */
+	rng.reciprocal = (65536 + rng.log2_inverse_p - 1) / rng.log2_inverse_p;
 	rng.max_value = max_value-1;
 	return rng;
 }
@@ -34,6 +63,11 @@ unsigned int rng_upper_bound(const RNG *rng) {
 
 unsigned int rng_get_value(RNG *r){
 	unsigned int value;
-	for (value = 0; toss(r->xsubi) < MAX_RN/2 && value < r->max_value; ++value);
+	if (r->algorithm == RNG_SPLITMIX64) {
+		/* Each group of log2_inverse_p trailing zero bits of a uniform draw is a successful promotion. */
+		value = (count_trailing_zeros(splitmix_next(&(r->state))) * r->reciprocal) >> 16;
+		return (value < r->max_value ? value : r->max_value);
+	}
+	for (value = 0; toss(&(r->state)) < MAX_RN/2 && value < r->max_value; ++value);
 	return value;
 }
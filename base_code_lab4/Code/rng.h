@@ -10,15 +10,31 @@
  *  @{
  */
 
+/**
+ * @brief Algorithms of the random number generator.
+ */
+typedef enum e_rng_algorithm {
+	/// 48 bits linear congruential generator, one draw per level, the reference sequence of the test files.
+	RNG_LCG48,
+	/// splitmix64 generator, one draw per value.
+	RNG_SPLITMIX64
+} RNGAlgorithm;
+
 /**
  * @brief Random number generator parameters.
  * In order to generate reproducible sequences of random numbers, this structure manages the seed of the sequence that will be updated at each new generated number.
  */
 typedef struct s_rng_ {
 	/// seed parameters.
-	unsigned short xsubi[3];
+	unsigned long long int state;
 	/// generates integer values values in [0 .. max_value]
 	unsigned int max_value;
+	/// the probability to generate a value greater than i given it is greater or equal to i is \f$ \frac{1}{2^{log2\_inverse\_p}} \f$
+	unsigned int log2_inverse_p;
+	/// \f$ \lceil \frac{2^{16}}{log2\_inverse\_p} \rceil \f$, to divide by log2_inverse_p with a multiplication.
+	unsigned int reciprocal;
+	/// algorithm of the generator.
+	RNGAlgorithm algorithm;
 } RNG;
 
 /**
@@ -29,6 +45,18 @@ typedef struct s_rng_ {
  */
 RNG rng_initialize(unsigned long long int seed, unsigned int max_value);
 
+/**
+ * @brief Initialize a fast random sequence at the given seed, with a given promotion probability.
+ * Each value is obtained from a single 64 bits draw of a splitmix64 generator, as the number of trailing zero bits of the draw
+ * divided by log2_inverse_p.
+ * @param seed is at least a 64 bits unsigned integer
+ * @param max_value : the strict upper bound of the generated values
+ * @param log2_inverse_p : the promotion probability is \f$ p = \frac{1}{2^{log2\_inverse\_p}} \f$, 1 for p = 1/2, 2 for p = 1/4.
+ * @post if rng = rng_initialize_geometric(s, u, k) then rng_upper_bound(rng) == u-1
+ * @note The generated values follow the law of rng_get_value() with p instead of 1/2, but not the sequence of rng_initialize().
+ */
+RNG rng_initialize_geometric(unsigned long long int seed, unsigned int max_value, unsigned int log2_inverse_p);
+
 /**
  * @brief Returns the upper bound of the generated values
  * @param rng : the sequence generator.
@@ -43,6 +71,11 @@ unsigned int rng_upper_bound(const RNG *rng);
  * \f$ (0 \le i < max\_value) \rightarrow P(i) = \frac{1}{2^{i+1}} \f$ \n
  *      \f$ p(max\_value) = \frac{1}{2^{max\_value}} \f$
  *
+ * or, for a generator initialized by rng_initialize_geometric() with a promotion probability p :
+ * @par
+ * \f$ (0 \le i < max\_value) \rightarrow P(i) = p^i (1-p) \f$ \n
+ *      \f$ P(max\_value) = p^{max\_value} \f$
+ *
  * @param rng : the sequence generator.
  * @return the generated number.
  */
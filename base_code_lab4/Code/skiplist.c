@@ -1,43 +1,406 @@
+#define _POSIX_C_SOURCE 200809L
+
 #include <stdlib.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
 #include <assert.h>
+#include <limits.h>
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#define SKIPLIST_USE_MMAP
+#endif
 
 #include "skiplist.h"
 #include "rng.h"
 
+/* A forward link and the value of the node it leads to, so that the search compares the value without loading the next node.
+   The width of a link is the number of level 0 links it spans, the sentinel being at position 0 before the first element and at
+   position size+1 after the last one. */
+typedef struct s_Link {
+	struct s_Node* next;
+	int key;
+	unsigned int width;
+} Link;
+
+/* A node of level l is allocated with its l forward links, followed by its l backward links.
+   Forward links come first, next to the value, as they are the only ones read by the search. */
 typedef struct s_Node {
 	int value;
 	int level;
-	struct s_Node** links;
+	Link forward[];
 } Node;
 
 struct s_SkipList {
+	/* The sentinel has SKIPLIST_MAX_LEVELS links, only the level first ones are used. */
 	Node* sentinel;
+	/* Number of levels holding at least one node, or 1 for an empty list. */
+	int level;
 	unsigned int size;
 	RNG rng;
+	/* The maximal level of the nodes, rng_upper_bound(rng) + 1, grows with the size of the list. */
+	bool dynamic;
+	/* Nodes removed from the list, kept for reuse. pool[i] is a list of pool_size[i] nodes of level i+1, chained by their first link. */
+	Node* pool[SKIPLIST_MAX_LEVELS];
+	unsigned int pool_size[SKIPLIST_MAX_LEVELS];
+#ifdef SKIPLIST_INSTRUMENT
+	/* Calls of insert, remove and search, and forward moves done by these calls. */
+	unsigned long long calls[3];
+	unsigned long long probes[3];
+#endif
 };
 
+#ifdef SKIPLIST_INSTRUMENT
+enum {STATS_INSERT, STATS_REMOVE, STATS_SEARCH};
+/* The counters are updated by the search too, the list is not defined as a constant object. */
+#define SKIPLIST_COUNT_CALL(d, operation) (((SkipList*)(d))->calls[operation]++)
+#define SKIPLIST_COUNT_PROBE(d, operation) (((SkipList*)(d))->probes[operation]++)
+#else
+#define SKIPLIST_COUNT_CALL(d, operation) ((void)0)
+#define SKIPLIST_COUNT_PROBE(d, operation) ((void)0)
+#endif
+
+size_t node_size(int level) {
+	return sizeof(Node) + level * (sizeof(Link) + sizeof(Node*));
+}
+
+Node** node_backward(const Node* n) {
+	return (Node**)(n->forward + n->level);
+}
+
+Node* node_create(SkipList* d, int value, int level) {
+	Node* new = d->pool[level-1];
+	if (new != NULL) {
+		d->pool[level-1] = new->forward[0].next;
+		d->pool_size[level-1]--;
+	} else
+		new = malloc(node_size(level));
+	new->value = value;
+	new->level = level;
+	return new;
+}
+
+/* A pool keeps about as many nodes as the list has at their level, the surplus is freed. The size of the list must be updated
+   before the release. */
+void node_release(SkipList* d, Node* n) {
+	int i = n->level-1;
+	n->forward[0].next = d->pool[i];
+	d->pool[i] = n;
+	d->pool_size[i]++;
+	while (d->pool_size[i] > (d->size >> i) + SKIPLIST_POOL_MIN_NODES) {
+		Node* surplus = d->pool[i];
+		d->pool[i] = surplus->forward[0].next;
+		d->pool_size[i]--;
+		free(surplus);
+	}
+}
+
 SkipList* skiplist_create(int nblevels) {
-	SkipList* sl = malloc(sizeof(SkipList) + sizeof(Node) + 2 * nblevels * sizeof(Node*));
+	if (nblevels == SKIPLIST_DYNAMIC_LEVELS) {
+		SkipList* d = skiplist_create_with_rng(rng_initialize(0, 1));
+		d->dynamic = true;
+		return d;
+	}
+	if (nblevels > SKIPLIST_MAX_LEVELS)
+		nblevels = SKIPLIST_MAX_LEVELS;
+	return skiplist_create_with_rng(rng_initialize(0, nblevels));
+}
+
+SkipList* skiplist_create_with_rng(RNG rng) {
+	int nblevels = rng_upper_bound(&rng) + 1;
+	if (nblevels > SKIPLIST_MAX_LEVELS) {
+		nblevels = SKIPLIST_MAX_LEVELS;
+		rng.max_value = nblevels - 1;
+	}
+	SkipList* sl = malloc(sizeof(SkipList) + node_size(SKIPLIST_MAX_LEVELS));
 	sl->sentinel = (Node*)(sl+1);
-	sl->sentinel->links = (Node**)(sl->sentinel+1);
+	sl->sentinel->value = -1;
+	sl->sentinel->level = SKIPLIST_MAX_LEVELS;
+
+	for (int i = 0; i < SKIPLIST_MAX_LEVELS; i++) {
+		sl->sentinel->forward[i].next = sl->sentinel;
+		sl->sentinel->forward[i].key = sl->sentinel->value;
+		sl->sentinel->forward[i].width = 1;
+		node_backward(sl->sentinel)[i] = sl->sentinel;
+	}
 
-	for (int i = 0; i < (2*nblevels); i++) {
-		sl->sentinel->links[i] = sl->sentinel;
+	for (int i = 0; i < SKIPLIST_MAX_LEVELS; i++) {
+		sl->pool[i] = NULL;
+		sl->pool_size[i] = 0;
 	}
 
+	sl->level = 1;
 	sl->size = 0;
-	sl->rng = rng_initialize(0, nblevels);
-	sl->sentinel->value = -1;
-	sl->sentinel->level = nblevels;
+	sl->rng = rng;
+	sl->dynamic = false;
+#ifdef SKIPLIST_INSTRUMENT
+	for (int i = 0; i < 3; i++)
+		sl->calls[i] = sl->probes[i] = 0;
+#endif
 	return sl;
 }
 
+/* Allow one more level each time the size of a dynamic list doubles, so that the maximal level is about log2(size) + 1. */
+void skiplist_grow(SkipList* d) {
+	if (d->dynamic && d->rng.max_value + 1 < SKIPLIST_MAX_LEVELS && (d->size >> (d->rng.max_value + 1)) != 0)
+		d->rng.max_value++;
+}
+
+/* Construction by appending nodes, in ascending order, after the last node of each level. */
+typedef struct s_SkipListTail {
+	Node* last[SKIPLIST_MAX_LEVELS];
+	unsigned int position[SKIPLIST_MAX_LEVELS];
+} SkipListTail;
+
+void skiplist_tail_init(SkipList* d, SkipListTail* tail) {
+	for (int i = 0; i < SKIPLIST_MAX_LEVELS; i++) {
+		tail->last[i] = d->sentinel;
+		tail->position[i] = 0;
+	}
+	d->size = 0;
+}
+
+/* Append a node whose value is greater than the value of the last appended one. */
+void skiplist_tail_append(SkipList* d, SkipListTail* tail, Node* n) {
+	unsigned int position = ++(d->size);
+	skiplist_grow(d);
+	for (int i = 0; i < n->level; i++) {
+		Link* link = &(tail->last[i]->forward[i]);
+		link->next = n;
+		link->key = n->value;
+		link->width = position - tail->position[i];
+		node_backward(n)[i] = tail->last[i];
+		tail->last[i] = n;
+		tail->position[i] = position;
+	}
+}
+
+/* Link the last node of each level to the sentinel. */
+void skiplist_tail_close(SkipList* d, SkipListTail* tail) {
+	d->level = 1;
+	for (int i = 0; i < SKIPLIST_MAX_LEVELS; i++) {
+		if (tail->last[i] != d->sentinel)
+			d->level = i + 1;
+		Link* link = &(tail->last[i]->forward[i]);
+		link->next = d->sentinel;
+		link->key = d->sentinel->value;
+		link->width = d->size + 1 - tail->position[i];
+		node_backward(d->sentinel)[i] = tail->last[i];
+	}
+}
+
+SkipList* skiplist_build_sorted(const int* values, unsigned int n, int nblevels) {
+	SkipList* d = skiplist_create(nblevels);
+	SkipListTail tail;
+	skiplist_tail_init(d, &tail);
+	bool valid = true;
+	for (unsigned int i = 0; i < n && valid; i++) {
+		valid = (i == 0 || values[i-1] < values[i]);
+		if (valid)
+			skiplist_tail_append(d, &tail, node_create(d, values[i], rng_get_value(&(d->rng))+1));
+	}
+	skiplist_tail_close(d, &tail);
+	if (!valid)
+		skiplist_delete(&d);
+	return d;
+}
+
+/* Kind of combination of two lists. */
+typedef enum e_SetOperation {SET_UNION, SET_INTERSECTION, SET_DIFFERENCE} SetOperation;
+
+/* Rebuild d1 with the nodes of d1 and d2 kept by the operation, walking both lists in ascending order, and delete d2.
+   Nodes that are not kept are released to the pool of d1. */
+SkipList* skiplist_combine(SkipList* d1, SkipList** d2, SetOperation operation) {
+	if (d1 == *d2) {
+		/* A list combined with itself is unchanged, except by the difference that empties it. */
+		if (operation == SET_DIFFERENCE)
+			skiplist_remove_range(d1, INT_MIN, INT_MAX);
+		*d2 = NULL;
+		return d1;
+	}
+	Node* a = d1->sentinel->forward[0].next;
+	Node* b = (*d2)->sentinel->forward[0].next;
+	SkipListTail tail;
+	skiplist_tail_init(d1, &tail);
+	while (a != d1->sentinel || b != (*d2)->sentinel) {
+		/* The next links are read before the node is appended to the result. */
+		if (b == (*d2)->sentinel || (a != d1->sentinel && a->value < b->value)) {
+			Node* next = a->forward[0].next;
+			if (operation != SET_INTERSECTION)
+				skiplist_tail_append(d1, &tail, a);
+			else
+				node_release(d1, a);
+			a = next;
+		} else if (a == d1->sentinel || b->value < a->value) {
+			Node* next = b->forward[0].next;
+			if (operation == SET_UNION)
+				skiplist_tail_append(d1, &tail, b);
+			else
+				node_release(d1, b);
+			b = next;
+		} else {
+			Node* next_a = a->forward[0].next;
+			Node* next_b = b->forward[0].next;
+			if (operation != SET_DIFFERENCE)
+				skiplist_tail_append(d1, &tail, a);
+			else
+				node_release(d1, a);
+			node_release(d1, b);
+			a = next_a;
+			b = next_b;
+		}
+	}
+	skiplist_tail_close(d1, &tail);
+	for (int i = 0; i < SKIPLIST_MAX_LEVELS; i++)
+		(*d2)->sentinel->forward[i].next = (*d2)->sentinel;
+	skiplist_delete(d2);
+	return d1;
+}
+
+SkipList* skiplist_union(SkipList* d1, SkipList** d2) {
+	return skiplist_combine(d1, d2, SET_UNION);
+}
+
+SkipList* skiplist_intersection(SkipList* d1, SkipList** d2) {
+	return skiplist_combine(d1, d2, SET_INTERSECTION);
+}
+
+SkipList* skiplist_difference(SkipList* d1, SkipList** d2) {
+	return skiplist_combine(d1, d2, SET_DIFFERENCE);
+}
+
+/* Binary image of a SkipList : this header, then the size values in ascending order, then the size levels of their nodes.
+   All the fields are in the byte order of the machine that saved the list. */
+typedef struct s_SkipListImage {
+	char magic[4];
+	uint32_t version;
+	uint32_t size;
+	uint32_t max_value;
+	uint64_t rng_state;
+	uint32_t rng_log2_inverse_p;
+	uint8_t rng_algorithm;
+	uint8_t dynamic;
+	uint8_t padding[2];
+} SkipListImage;
+
+static const char skiplist_magic[4] = {'S', 'K', 'P', 'L'};
+#define SKIPLIST_IMAGE_VERSION 1
+
+bool skiplist_save(const SkipList* d, const char* path) {
+	FILE* output = fopen(path, "wb");
+	if (output == NULL)
+		return false;
+	SkipListImage header;
+	memset(&header, 0, sizeof(header));
+	memcpy(header.magic, skiplist_magic, sizeof(header.magic));
+	header.version = SKIPLIST_IMAGE_VERSION;
+	header.size = d->size;
+	header.max_value = d->rng.max_value;
+	header.rng_state = d->rng.state;
+	header.rng_log2_inverse_p = d->rng.log2_inverse_p;
+	header.rng_algorithm = (uint8_t)d->rng.algorithm;
+	header.dynamic = d->dynamic;
+
+	int32_t* values = malloc(d->size * sizeof(int32_t) + 1);
+	uint8_t* levels = malloc(d->size * sizeof(uint8_t) + 1);
+	unsigned int i = 0;
+	for (Node *elem = d->sentinel->forward[0].next; elem != d->sentinel; elem = elem->forward[0].next, i++) {
+		values[i] = elem->value;
+		levels[i] = (uint8_t)elem->level;
+	}
+	bool ok = fwrite(&header, sizeof(header), 1, output) == 1
+		&& fwrite(values, sizeof(int32_t), d->size, output) == d->size
+		&& fwrite(levels, sizeof(uint8_t), d->size, output) == d->size;
+	free(values);
+	free(levels);
+	return (fclose(output) == 0) && ok;
+}
+
+/* Build the list described by an image of length bytes, NULL if the image is not valid. */
+SkipList* skiplist_from_image(const unsigned char* image, size_t length) {
+	SkipListImage header;
+	if (length < sizeof(header))
+		return NULL;
+	memcpy(&header, image, sizeof(header));
+	if (memcmp(header.magic, skiplist_magic, sizeof(header.magic)) != 0 || header.version != SKIPLIST_IMAGE_VERSION
+		|| header.max_value >= SKIPLIST_MAX_LEVELS || header.rng_log2_inverse_p == 0
+		|| (header.rng_algorithm != RNG_LCG48 && header.rng_algorithm != RNG_SPLITMIX64)
+		|| length < sizeof(header) + (size_t)header.size * (sizeof(int32_t) + sizeof(uint8_t)))
+		return NULL;
+	const int32_t* values = (const int32_t*)(image + sizeof(header));
+	const uint8_t* levels = (const uint8_t*)(values + header.size);
+
+	/* The generator is rebuilt by its constructor, that also computes the fields not saved in the image. */
+	RNG rng = (header.rng_algorithm == RNG_SPLITMIX64 ? rng_initialize_geometric(0, header.max_value + 1, header.rng_log2_inverse_p)
+			   : rng_initialize(0, header.max_value + 1));
+	rng.state = header.rng_state;
+	SkipList* d = skiplist_create_with_rng(rng);
+	d->dynamic = header.dynamic;
+	SkipListTail tail;
+	skiplist_tail_init(d, &tail);
+	bool valid = true;
+	for (unsigned int i = 0; i < header.size && valid; i++) {
+		valid = (levels[i] >= 1 && levels[i] <= SKIPLIST_MAX_LEVELS && (i == 0 || values[i-1] < values[i]));
+		if (valid)
+			skiplist_tail_append(d, &tail, node_create(d, values[i], levels[i]));
+	}
+	skiplist_tail_close(d, &tail);
+	/* The appended nodes made a dynamic list grow, the saved generator is restored. */
+	d->rng = rng;
+	if (!valid)
+		skiplist_delete(&d);
+	return d;
+}
+
+SkipList* skiplist_load(const char* path) {
+	SkipList* d = NULL;
+#ifdef SKIPLIST_USE_MMAP
+	int fd = open(path, O_RDONLY);
+	if (fd < 0)
+		return NULL;
+	struct stat info;
+	if (fstat(fd, &info) == 0 && info.st_size > 0) {
+		/* The values are read directly from the mapped file. */
+		void* image = mmap(NULL, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+		if (image != MAP_FAILED) {
+			d = skiplist_from_image(image, info.st_size);
+			munmap(image, info.st_size);
+		}
+	}
+	close(fd);
+#else
+	FILE* input = fopen(path, "rb");
+	if (input == NULL)
+		return NULL;
+	if (fseek(input, 0, SEEK_END) == 0) {
+		long length = ftell(input);
+		unsigned char* image = (length > 0 ? malloc(length) : NULL);
+		rewind(input);
+		if (image != NULL && fread(image, 1, length, input) == (size_t)length)
+			d = skiplist_from_image(image, length);
+		free(image);
+	}
+	fclose(input);
+#endif
+	return d;
+}
+
 void skiplist_delete(SkipList** d) {
-	Node* prev_elem = (*d)->sentinel->links[(*d)->sentinel->level];
-	for (Node *elem = prev_elem->links[prev_elem->level]; elem != (*d)->sentinel->links[(*d)->sentinel->level]; elem = elem->links[elem->level]) {
-		free(prev_elem);
-		prev_elem = elem;
+	Node* elem = (*d)->sentinel->forward[0].next;
+	while (elem != (*d)->sentinel) {
+		Node* next = elem->forward[0].next;
+		free(elem);
+		elem = next;
 	}
+	for (int i = 0; i < SKIPLIST_MAX_LEVELS; i++)
+		while ((*d)->pool[i] != NULL) {
+			Node* n = (*d)->pool[i];
+			(*d)->pool[i] = n->forward[0].next;
+			free(n);
+		}
 	free(*d);
 	*d=NULL;
 }
@@ -46,18 +409,92 @@ unsigned int skiplist_size(const SkipList* d) {
 	return d->size;
 }
 
+void skiplist_stats(const SkipList* d, SkipListStats* stats) {
+	memset(stats, 0, sizeof(SkipListStats));
+	/* The counters are read before the searches done below, and restored after them. */
+#ifdef SKIPLIST_INSTRUMENT
+	stats->instrumented = true;
+	stats->insert_calls = d->calls[STATS_INSERT];
+	stats->insert_probes = d->probes[STATS_INSERT];
+	stats->remove_calls = d->calls[STATS_REMOVE];
+	stats->remove_probes = d->probes[STATS_REMOVE];
+	stats->search_calls = d->calls[STATS_SEARCH];
+	stats->search_probes = d->probes[STATS_SEARCH];
+#endif
+	stats->size = d->size;
+	stats->nblevels = rng_upper_bound(&(d->rng)) + 1;
+	stats->levels = d->level;
+	stats->bytes = sizeof(SkipList) + node_size(SKIPLIST_MAX_LEVELS);
+	for (Node *elem = d->sentinel->forward[0].next; elem != d->sentinel; elem = elem->forward[0].next) {
+		stats->nodes_by_level[elem->level-1]++;
+		stats->bytes += node_size(elem->level);
+		/* Forward moves of the search of the element. */
+		unsigned int length = 0;
+		skiplist_search(d, elem->value, &length);
+		stats->mean_search_length += length;
+		if (length > stats->max_search_length)
+			stats->max_search_length = length;
+	}
+	for (int i = SKIPLIST_MAX_LEVELS-1; i >= 0; i--)
+		stats->population[i] = stats->nodes_by_level[i] + (i+1 < SKIPLIST_MAX_LEVELS ? stats->population[i+1] : 0);
+	for (int i = 0; i < SKIPLIST_MAX_LEVELS; i++)
+		for (Node* n = d->pool[i]; n != NULL; n = n->forward[0].next) {
+			stats->pool_bytes += node_size(i+1);
+			stats->pool_nodes++;
+		}
+	if (d->size > 0) {
+		stats->mean_search_length /= d->size;
+		stats->bytes_per_element = (double)stats->bytes / d->size;
+	}
+#ifdef SKIPLIST_INSTRUMENT
+	((SkipList*)d)->calls[STATS_SEARCH] = stats->search_calls;
+	((SkipList*)d)->probes[STATS_SEARCH] = stats->search_probes;
+#endif
+}
+
 int skiplist_at(const SkipList* d, unsigned int i) {
 	if (i < skiplist_size(d)) {
-		Node* posi = d->sentinel->links[d->sentinel->level];
-		for (; i > 0; --i, posi = posi->links[posi->level]);
-		return posi->value;
+		/* The ith element is at position i+1, reached by following the widest links that do not go past it. */
+		Node* cursor = d->sentinel;
+		unsigned int position = 0;
+		for (int cur_l = d->level-1; cur_l >= 0; cur_l--)
+			while (cursor->forward[cur_l].next != d->sentinel && position + cursor->forward[cur_l].width <= i+1) {
+				position += cursor->forward[cur_l].width;
+				cursor = cursor->forward[cur_l].next;
+			}
+		return cursor->value;
 	}
 	else
 		return 0;
 }
 
+unsigned int skiplist_rank(const SkipList* d, int value) {
+	Node* cursor = d->sentinel;
+	unsigned int position = 0;
+	for (int cur_l = d->level-1; cur_l >= 0; cur_l--)
+		while (cursor->forward[cur_l].next != d->sentinel && cursor->forward[cur_l].key < value) {
+			position += cursor->forward[cur_l].width;
+			cursor = cursor->forward[cur_l].next;
+		}
+	return position;
+}
+
 void skiplist_map(const SkipList* d, ScanOperator f, void *environment) {
-	for (Node *elem = d->sentinel->links[d->sentinel->level]; elem != d->sentinel; elem = elem->links[elem->level])
+	for (Node *elem = d->sentinel->forward[0].next; elem != d->sentinel; elem = elem->forward[0].next)
+		f(elem->value, environment);
+}
+
+/* First node whose value is greater or equal to value, the sentinel if there is none. */
+Node* skiplist_lower_bound(const SkipList* d, int value) {
+	Node* cursor = d->sentinel;
+	for (int cur_l = d->level-1; cur_l >= 0; cur_l--)
+		while (cursor->forward[cur_l].next != d->sentinel && cursor->forward[cur_l].key < value)
+			cursor = cursor->forward[cur_l].next;
+	return cursor->forward[0].next;
+}
+
+void skiplist_range(const SkipList* d, int lo, int hi, ScanOperator f, void *environment) {
+	for (Node *elem = skiplist_lower_bound(d, lo); elem != d->sentinel && elem->value <= hi; elem = elem->forward[0].next)
 		f(elem->value, environment);
 }
 
@@ -65,32 +502,49 @@ void skiplist_map(const SkipList* d, ScanOperator f, void *environment) {
 /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~|| ./skiplisttest -c ||~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
 
 SkipList* skiplist_insert(SkipList* d, int value) {
-	int cur_l = d->sentinel->level-1;
-	Node** update = malloc((cur_l+1)*sizeof(Node*));
+	int cur_l = d->level-1;
+	Node* update[SKIPLIST_MAX_LEVELS];
+	unsigned int position[SKIPLIST_MAX_LEVELS];
 	Node* cursor = d->sentinel;
+	unsigned int cur_p = 0;
+	SKIPLIST_COUNT_CALL(d, STATS_INSERT);
 	for (; cur_l >= 0; cur_l--) {
-		while (cursor->links[cursor->level + cur_l] != d->sentinel && cursor->links[cursor->level + cur_l]->value < value)
-			cursor = cursor->links[cursor->level + cur_l];
+		while (cursor->forward[cur_l].next != d->sentinel && cursor->forward[cur_l].key < value) {
+			cur_p += cursor->forward[cur_l].width;
+			cursor = cursor->forward[cur_l].next;
+			SKIPLIST_COUNT_PROBE(d, STATS_INSERT);
+		}
 		update[cur_l] = cursor;
+		position[cur_l] = cur_p;
 	}
 
-	cursor = cursor->links[cursor->level];
-	if (cursor == d->sentinel || cursor->value != value) {
+	if (cursor->forward[0].next == d->sentinel || cursor->forward[0].key != value) {
 		int level = rng_get_value(&(d->rng))+1;
-		Node* new = malloc(sizeof(Node) + 2 * level * sizeof(Node*));
-		new->value = value;
-		new->level = level;
-		new->links = (Node**)(new+1);
+		Node* new = node_create(d, value, level);
+		unsigned int new_p = cur_p + 1;
+		/* The new node populates new levels, whose only link goes from the sentinel to itself. */
+		for (; d->level < level; d->level++) {
+			d->sentinel->forward[d->level].next = d->sentinel;
+			d->sentinel->forward[d->level].width = d->size + 1;
+			update[d->level] = d->sentinel;
+			position[d->level] = 0;
+		}
 
 		for (cur_l = 0; cur_l < level; cur_l++) {
-			update[cur_l]->links[update[cur_l]->level + cur_l]->links[cur_l] = new;
-			new->links[level + cur_l] = update[cur_l]->links[update[cur_l]->level + cur_l];
-			update[cur_l]->links[update[cur_l]->level + cur_l] = new;
-			new->links[cur_l] = update[cur_l];
+			Link* link = &(update[cur_l]->forward[cur_l]);
+			new->forward[cur_l] = *link;
+			new->forward[cur_l].width = position[cur_l] + link->width + 1 - new_p;
+			node_backward(new)[cur_l] = update[cur_l];
+			node_backward(link->next)[cur_l] = new;
+			link->next = new;
+			link->key = value;
+			link->width = new_p - position[cur_l];
 		}
+		for (; cur_l < d->level; cur_l++)
+			update[cur_l]->forward[cur_l].width++;
 		(d->size)++;
+		skiplist_grow(d);
 	}
-	free(update);
 	return d;
 }
 
@@ -98,70 +552,177 @@ SkipList* skiplist_insert(SkipList* d, int value) {
 /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~|| ./skiplisttest -s ||~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
 
 bool skiplist_search(const SkipList* d, int value, unsigned int *nb_operations) {
-	int cur_l = d->sentinel->level-1;
+	int cur_l = d->level-1;
 	Node* cursor = d->sentinel;
+	SKIPLIST_COUNT_CALL(d, STATS_SEARCH);
 	for (; cur_l >= 0; cur_l--) {
-		while (cursor->links[cursor->level + cur_l] != d->sentinel && cursor->links[cursor->level + cur_l]->value < value) {
-			cursor = cursor->links[cursor->level + cur_l];
+		while (cursor->forward[cur_l].next != d->sentinel && cursor->forward[cur_l].key < value) {
+			cursor = cursor->forward[cur_l].next;
 			(*nb_operations)++;
+			SKIPLIST_COUNT_PROBE(d, STATS_SEARCH);
 		}
-		if (cursor->links[cursor->level + cur_l]->value == value)
+		if (cursor->forward[cur_l].next != d->sentinel && cursor->forward[cur_l].key == value)
 			return true;
 	}
 	return false;
 }
 
+/* A query of a batch and its index in the batch. */
+typedef struct s_Query {
+	int value;
+	unsigned int index;
+} Query;
+
+int query_compare(const void* a, const void* b) {
+	int x = ((const Query*)a)->value, y = ((const Query*)b)->value;
+	return (x > y) - (x < y);
+}
+
+unsigned int skiplist_search_batch(const SkipList* d, const int* values, unsigned int n, bool* results, unsigned int *nb_operations) {
+	Query* queries = NULL;
+	unsigned int i = 1;
+	for (; i < n && values[i-1] <= values[i]; i++);
+	if (i < n) {
+		queries = malloc(n * sizeof(Query));
+		for (i = 0; i < n; i++) {
+			queries[i].value = values[i];
+			queries[i].index = i;
+		}
+		qsort(queries, n, sizeof(Query), query_compare);
+	}
+
+	/* finger[l] is the last node of level l whose value is lower than the previous query. */
+	Node* finger[SKIPLIST_MAX_LEVELS];
+	int top = d->level-1;
+	for (int cur_l = 0; cur_l <= top; cur_l++)
+		finger[cur_l] = d->sentinel;
+	unsigned int found = 0;
+	for (i = 0; i < n; i++) {
+		int value = (queries != NULL ? queries[i].value : values[i]);
+		/* Climb while the upper level leads further than the value, then search down from there. */
+		int cur_l = 0;
+		while (cur_l < top && finger[cur_l+1]->forward[cur_l+1].next != d->sentinel && finger[cur_l+1]->forward[cur_l+1].key < value)
+			cur_l++;
+		Node* cursor = finger[cur_l];
+		for (; cur_l >= 0; cur_l--) {
+			while (cursor->forward[cur_l].next != d->sentinel && cursor->forward[cur_l].key < value) {
+				cursor = cursor->forward[cur_l].next;
+				(*nb_operations)++;
+			}
+			finger[cur_l] = cursor;
+		}
+		bool result = (cursor->forward[0].next != d->sentinel && cursor->forward[0].key == value);
+		results[queries != NULL ? queries[i].index : i] = result;
+		found += result;
+	}
+	free(queries);
+	return found;
+}
+
 
 /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~|| ./skiplisttest -r ||~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
 
 SkipList* skiplist_remove(SkipList* d, int value) {
-	int cur_l = d->sentinel->level-1;
-	Node** update = malloc((cur_l+1)*sizeof(Node*));
+	int cur_l = d->level-1;
+	Node* update[SKIPLIST_MAX_LEVELS];
 	Node* cursor = d->sentinel;
+	SKIPLIST_COUNT_CALL(d, STATS_REMOVE);
 	for (; cur_l >= 0; cur_l--) {
-		while (cursor->links[cursor->level + cur_l] != d->sentinel && cursor->links[cursor->level + cur_l]->value < value)
-			cursor = cursor->links[cursor->level + cur_l];
+		while (cursor->forward[cur_l].next != d->sentinel && cursor->forward[cur_l].key < value) {
+			cursor = cursor->forward[cur_l].next;
+			SKIPLIST_COUNT_PROBE(d, STATS_REMOVE);
+		}
 		update[cur_l] = cursor;
 	}
 
-	cursor = cursor->links[cursor->level];
-	if (cursor->value == value) {
+	cursor = cursor->forward[0].next;
+	if (cursor != d->sentinel && cursor->value == value) {
 		for (cur_l = 0; cur_l < cursor->level; cur_l++) {
-			update[cur_l]->links[update[cur_l]->level + cur_l] = cursor->links[cursor->level + cur_l];
-			cursor->links[cursor->level + cur_l]->links[cur_l] = update[cur_l];
+			unsigned int width = update[cur_l]->forward[cur_l].width + cursor->forward[cur_l].width - 1;
+			update[cur_l]->forward[cur_l] = cursor->forward[cur_l];
+			update[cur_l]->forward[cur_l].width = width;
+			node_backward(cursor->forward[cur_l].next)[cur_l] = update[cur_l];
 		}
+		for (; cur_l < d->level; cur_l++)
+			update[cur_l]->forward[cur_l].width--;
+		while (d->level > 1 && d->sentinel->forward[d->level-1].next == d->sentinel)
+			d->level--;
 		(d->size)--;
-		free(cursor);
+		node_release(d, cursor);
 	}
-	free(update);
 	return d;
 }
 
+unsigned int skiplist_remove_range(SkipList* d, int lo, int hi) {
+	if (lo > hi)
+		return 0;
+	Node* update[SKIPLIST_MAX_LEVELS];
+	Node* cursor = d->sentinel;
+	SKIPLIST_COUNT_CALL(d, STATS_REMOVE);
+	for (int cur_l = d->level-1; cur_l >= 0; cur_l--) {
+		while (cursor->forward[cur_l].next != d->sentinel && cursor->forward[cur_l].key < lo) {
+			cursor = cursor->forward[cur_l].next;
+			SKIPLIST_COUNT_PROBE(d, STATS_REMOVE);
+		}
+		update[cur_l] = cursor;
+	}
 
-/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~|| ./skiplisttest -i ||~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+	Node* first = update[0]->forward[0].next;
+	unsigned int removed = 0;
+	/* At each level, the link of the predecessor jumps over the nodes of the run, its width being the sum of the widths of
+	   the jumped links minus the number of removed nodes, given by level 0 whose links have width 1.
+	   The run ends at the first link whose cached key is greater than hi, so that the node following the run is only loaded
+	   at the levels where its backward link changes. */
+	for (int cur_l = 0; cur_l < d->level; cur_l++) {
+		Link* link = &(update[cur_l]->forward[cur_l]);
+		Link* last = link;
+		unsigned int width = link->width;
+		while (last->next != d->sentinel && last->key <= hi) {
+			last = &(last->next->forward[cur_l]);
+			width += last->width;
+		}
+		if (cur_l == 0 && (removed = width - 1) == 0)
+			return 0;
+		if (last != link) {
+			node_backward(last->next)[cur_l] = update[cur_l];
+			*link = *last;
+		}
+		link->width = width - removed;
+	}
 
-struct s_SkipListIterator {
-	SkipList* skiplist;
-	Node* begin;
-	Node* current;
-	IteratorDirection direction;
-};
+	d->size -= removed;
+	for (unsigned int i = 0; i < removed; i++) {
+		Node* next = first->forward[0].next;
+		node_release(d, first);
+		first = next;
+	}
+	while (d->level > 1 && d->sentinel->forward[d->level-1].next == d->sentinel)
+		d->level--;
+	return removed;
+}
 
-SkipListIterator* skiplist_iterator_create(SkipList* d, IteratorDirection w) {
-	SkipListIterator* it = malloc(sizeof(struct s_SkipListIterator));
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~|| ./skiplisttest -i ||~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+SkipListIterator* skiplist_iterator_init(SkipListIterator* it, SkipList* d, IteratorDirection w) {
 	it->skiplist = d;
 	it->direction = w;
-	it->begin = (w == FORWARD_ITERATOR ? d->sentinel->links[d->sentinel->level] : d->sentinel->links[0]);
-	it->current = it->begin;
-	return it;
+	return skiplist_iterator_begin(it);
+}
+
+SkipListIterator* skiplist_iterator_create(SkipList* d, IteratorDirection w) {
+	return skiplist_iterator_init(malloc(sizeof(SkipListIterator)), d, w);
 }
 
 void skiplist_iterator_delete(SkipListIterator** it) {
 	free(*it);
+	*it = NULL;
 }
 
+/* The beginning is read from the sentinel, so that it follows the insertions and removals done since the construction. */
 SkipListIterator* skiplist_iterator_begin(SkipListIterator* it) {
-	it->current = it->begin;
+	Node* sentinel = it->skiplist->sentinel;
+	it->current = (it->direction == FORWARD_ITERATOR ? sentinel->forward[0].next : node_backward(sentinel)[0]);
 	return it;
 }
 
@@ -170,10 +731,47 @@ bool skiplist_iterator_end(SkipListIterator* it) {
 }
 
 SkipListIterator* skiplist_iterator_next(SkipListIterator* it) {
-	it->current = (it->direction == FORWARD_ITERATOR ? it->current->links[it->current->level] : it->current->links[0]);
+	it->current = (it->direction == FORWARD_ITERATOR ? it->current->forward[0].next : node_backward(it->current)[0]);
 	return it;
 }
 
 int skiplist_iterator_value(SkipListIterator* it) {
 	return it->current->value;
-}
\ No newline at end of file
+}
+
+SkipListIterator* skiplist_iterator_seek(SkipListIterator* it, int value) {
+	it->current = skiplist_lower_bound(it->skiplist, value);
+	if (it->direction == BACKWARD_ITERATOR && (it->current == it->skiplist->sentinel || it->current->value != value))
+		it->current = node_backward(it->current)[0];
+	return it;
+}
+
+SkipListIterator* skiplist_iterator_erase(SkipListIterator* it) {
+	SkipList* d = it->skiplist;
+	Node* n = it->current;
+	assert(n != d->sentinel);
+	SKIPLIST_COUNT_CALL(d, STATS_REMOVE);
+	it->current = (it->direction == FORWARD_ITERATOR ? n->forward[0].next : node_backward(n)[0]);
+
+	int cur_l = 0;
+	for (; cur_l < n->level; cur_l++) {
+		Node* pred = node_backward(n)[cur_l];
+		unsigned int width = pred->forward[cur_l].width + n->forward[cur_l].width - 1;
+		pred->forward[cur_l] = n->forward[cur_l];
+		pred->forward[cur_l].width = width;
+		node_backward(n->forward[cur_l].next)[cur_l] = pred;
+	}
+	/* The link jumping over n at an upper level leaves its closest predecessor of that level, reached by climbing the
+	   backward links of the highest levels of the predecessors. */
+	Node* pred = node_backward(n)[n->level-1];
+	for (; cur_l < d->level; cur_l++) {
+		while (pred->level <= cur_l)
+			pred = node_backward(pred)[pred->level-1];
+		pred->forward[cur_l].width--;
+	}
+	while (d->level > 1 && d->sentinel->forward[d->level-1].next == d->sentinel)
+		d->level--;
+	(d->size)--;
+	node_release(d, n);
+	return it;
+}
@@ -4,6 +4,8 @@
 
 #include <stdio.h>
 
+#include "rng.h"
+
 /**
  *	@defgroup SkipListAT SkipList abstract type
  *  @brief Definition of the SkipList type and operators
@@ -11,6 +13,22 @@
  */
 
 
+/**
+ *	@brief Maximal number of levels of a SkipList.
+ */
+#define SKIPLIST_MAX_LEVELS 32
+
+/**
+ *	@brief Number of levels given to skiplist_create() for a SkipList whose number of levels grows with its size.
+ */
+#define SKIPLIST_DYNAMIC_LEVELS 0
+
+/**
+ *	@brief Number of removed nodes of each level kept for reuse by a SkipList, in addition to size / 2^(level-1) nodes.
+ *	The surplus is freed, so that a list that shrinks gives its memory back.
+ */
+#define SKIPLIST_POOL_MIN_NODES 16
+
 /**
  *	@brief Opaque definition of the SkipList abstract data type.
  */
@@ -28,11 +46,44 @@ typedef void(*ScanOperator)(int, void*);
  * @parblock
  *	skiplist_create : \f$\rightarrow\f$ SkipList.
  * @endparblock
- *	@param nblevels the number of levels in the skip list.
+ *	@param nblevels the number of levels in the skip list, at most SKIPLIST_MAX_LEVELS, or SKIPLIST_DYNAMIC_LEVELS to let the
+ *	number of levels grow as \f$ \log_2(size) + 1 \f$ when elements are inserted.
  *  @return a correctly initialized SkipList.
+ *  @note Whatever the number of levels, searches start from the highest level holding an element.
  */
 SkipList* skiplist_create(int nblevels);
 
+/**
+ *  @brief Constructor of an empty SkipList drawing the levels of its nodes with a given generator.
+ *
+ * @par Profile
+ * @parblock
+ *	skiplist_create_with_rng : RNG \f$\rightarrow\f$ SkipList.
+ * @endparblock
+ *	@param rng the generator of the levels, whose values define the number of levels of the skip list,
+ *	rng_upper_bound(rng) + 1, at most SKIPLIST_MAX_LEVELS.
+ *  @return a correctly initialized SkipList.
+ *  @note skiplist_create(n) uses rng_initialize(0, n), the generator of the reference test files. A generator built by
+ *  rng_initialize_geometric() is faster and allows to choose the promotion probability.
+ */
+SkipList* skiplist_create_with_rng(RNG rng);
+
+/**
+ *  @brief Constructor of a SkipList from an array of distinct values sorted in ascending order.
+ *
+ * @par Profile
+ * @parblock
+ *	skiplist_build_sorted : int[] \f$\times\f$ unsigned int \f$\times\f$ int \f$\rightarrow\f$ SkipList.
+ * @endparblock
+ *	@param values the values to put in the skiplist, in strictly ascending order.
+ *	@param n the number of values.
+ *	@param nblevels the number of levels in the skip list, at most SKIPLIST_MAX_LEVELS.
+ *  @return a SkipList holding the values, or NULL if the values are not strictly ascending.
+ *  @pre \f$ \forall i : (0 < i < n) \rightarrow (values[i-1] < values[i]) \f$, checked while the list is built.
+ *  @note The nodes are appended at the end of each level, so the construction is done in O(n) instead of O(n log n) for n insertions.
+ */
+SkipList* skiplist_build_sorted(const int* values, unsigned int n, int nblevels);
+
 /**
  *  @brief Destructor of a SkipList.
  *
@@ -45,6 +96,34 @@ SkipList* skiplist_create(int nblevels);
  */
 void skiplist_delete(SkipList** d);
 
+/**
+ *  @brief Save a SkipList in a binary file.
+ *
+ * @par Profile
+ * @parblock
+ *	skiplist_save : SkipList \f$\times\f$ string \f$\rightarrow\f$ bool
+ * @endparblock
+ *	@param d the SkipList to save.
+ *	@param path the name of the file to write.
+ *  @return true if the file was written.
+ *  @note The file holds the values in ascending order and the level of their nodes, 5 bytes per element, in the byte order of
+ *  the machine. The state of the level generator is saved too, so that a loaded list goes on with the same levels.
+ */
+bool skiplist_save(const SkipList* d, const char* path);
+
+/**
+ *  @brief Constructor of a SkipList from a file written by skiplist_save().
+ *
+ * @par Profile
+ * @parblock
+ *	skiplist_load : string \f$\rightarrow\f$ SkipList
+ * @endparblock
+ *	@param path the name of the file to read.
+ *  @return the saved SkipList, with the same nodes, or NULL if the file can not be read or is not a saved SkipList.
+ *  @note The file is mapped in memory when the system allows it, and the links are built in a single pass over the values.
+ */
+SkipList* skiplist_load(const char* path);
+
 /**
  *  @brief Access to the size the SkipList.
  *
@@ -80,9 +159,79 @@ unsigned int skiplist_size(const SkipList* d);
  * @parblock
  * (skiplist_at(d, i) = x) \f$\wedge\f$ ( (\f$\nu\f$ y : ( (skiplist_search(d, y) = true) \f$\wedge\f$  (y \f$\le\f$ x) )) = i ) 
  * @endparblock
+ * @note Each link stores the number of elements it spans, so that the access is done in O(log n).
  */
 int skiplist_at(const SkipList* d, unsigned int i);
 
+/**
+ *  @brief Rank of a value in the SkipList.
+ *
+ * @par Profile
+ * @parblock
+ *	skiplist_rank : SkipList \f$\times\f$ int \f$\rightarrow\f$ unsigned int
+ * @endparblock
+ *	@param d the SkipList to access
+ *	@param value the value to locate
+ *  @return the number of elements of the SkipList lower than value.
+ * @par Axioms
+ * @parblock
+ * (skiplist_search(d, x) = true) \f$\rightarrow\f$ skiplist_at(d, skiplist_rank(d, x)) = x \n
+ * skiplist_rank(d, skiplist_at(d, i)) = i
+ * @endparblock
+ */
+unsigned int skiplist_rank(const SkipList* d, int value);
+
+
+/**
+ *	@brief Statistics about the structure of a SkipList.
+ */
+typedef struct s_SkipListStats {
+	/// number of elements.
+	unsigned int size;
+	/// maximal level of the nodes.
+	int nblevels;
+	/// number of levels holding at least one node.
+	int levels;
+	/// nodes_by_level[i] is the number of nodes of level i+1.
+	unsigned int nodes_by_level[SKIPLIST_MAX_LEVELS];
+	/// population[i] is the number of nodes linked at level i.
+	unsigned int population[SKIPLIST_MAX_LEVELS];
+	/// mean number of forward moves to search an element of the list.
+	double mean_search_length;
+	/// maximal number of forward moves to search an element of the list.
+	unsigned int max_search_length;
+	/// memory used by the list and its nodes, in bytes.
+	size_t bytes;
+	/// bytes divided by size.
+	double bytes_per_element;
+	/// memory used by the removed nodes kept for reuse, in bytes.
+	size_t pool_bytes;
+	/// number of removed nodes kept for reuse.
+	unsigned int pool_nodes;
+	/// true if the counters below are maintained, when skiplist.c is compiled with SKIPLIST_INSTRUMENT defined.
+	bool instrumented;
+	/// calls of skiplist_insert and forward moves done by these calls.
+	unsigned long long insert_calls, insert_probes;
+	/// calls of skiplist_remove and forward moves done by these calls.
+	unsigned long long remove_calls, remove_probes;
+	/// calls of skiplist_search and forward moves done by these calls.
+	unsigned long long search_calls, search_probes;
+} SkipListStats;
+
+/**
+ *  @brief Compute statistics about a SkipList.
+ *
+ * @par Profile
+ * @parblock
+ *	skiplist_stats : SkipList \f$\rightarrow\f$ SkipListStats
+ * @endparblock
+ *	@param d the SkipList to analyse
+ *	@param stats the statistics, filled by the function
+ *  @note The search lengths are measured by searching each element, the function is in O(n log n).
+ *  The counters of the calls are only maintained when skiplist.c is compiled with SKIPLIST_INSTRUMENT defined
+ *  (<tt>make INSTRUMENT=yes</tt>), the searches done by skiplist_stats are not counted.
+ */
+void skiplist_stats(const SkipList* d, SkipListStats* stats);
 
 /**
  *	@brief Insert the value v in the skip list d.
@@ -113,6 +262,55 @@ SkipList* skiplist_insert(SkipList* d, int value);
  */
 SkipList* skiplist_remove(SkipList* d, int value);
 
+/**
+ *	@brief Remove all the values of an interval from the skip list d.
+ *	@param d the SkipList to remove from
+ *	@param lo the lowest value to remove
+ *	@param hi the greatest value to remove
+ *  @return the number of removed values.
+ *	@note the parameter d is modified by side effect
+ *	@note The predecessors of the interval are searched once, then each level is relinked in a single pass over the removed
+ *	nodes, in O(log(n) + k) for k removed values.
+ *	@see skiplist_remove
+ */
+unsigned int skiplist_remove_range(SkipList* d, int lo, int hi);
+
+
+/**
+ *	@brief Union of two skip lists.
+ *	@param d1 the first SkipList, that receives the result
+ *	@param d2 the second SkipList, deleted by the function
+ *  @return d1, holding the values of d1 or d2.
+ *	@note the parameter d1 is modified by side effect and is returned by the function, the parameter d2 is set to NULL.
+ *	When d2 designs d1, d1 is not deleted : it is left unchanged by the union and the intersection, and emptied by the difference.
+ *	@note Both lists are walked once in ascending order and the result is built with their nodes, in O(m + n) and without
+ *	allocation.
+ */
+SkipList* skiplist_union(SkipList* d1, SkipList** d2);
+
+/**
+ *	@brief Intersection of two skip lists.
+ *	@param d1 the first SkipList, that receives the result
+ *	@param d2 the second SkipList, deleted by the function
+ *  @return d1, holding the values of d1 that are in d2.
+ *	@note the parameter d1 is modified by side effect and is returned by the function, the parameter d2 is set to NULL.
+ *	When d2 designs d1, d1 is not deleted : it is left unchanged by the union and the intersection, and emptied by the difference.
+ *	@note The nodes that are not kept are given to d1 for reuse, the operation is in O(m + n).
+ *	@see skiplist_union
+ */
+SkipList* skiplist_intersection(SkipList* d1, SkipList** d2);
+
+/**
+ *	@brief Difference of two skip lists.
+ *	@param d1 the first SkipList, that receives the result
+ *	@param d2 the second SkipList, deleted by the function
+ *  @return d1, holding the values of d1 that are not in d2.
+ *	@note the parameter d1 is modified by side effect and is returned by the function, the parameter d2 is set to NULL.
+ *	When d2 designs d1, d1 is not deleted : it is left unchanged by the union and the intersection, and emptied by the difference.
+ *	@note The nodes that are not kept are given to d1 for reuse, the operation is in O(m + n).
+ *	@see skiplist_union
+ */
+SkipList* skiplist_difference(SkipList* d1, SkipList** d2);
 
 /**
  *  @brief Search for the presence of a value in a SkipList.
@@ -129,6 +327,24 @@ SkipList* skiplist_remove(SkipList* d, int value);
  */
 bool skiplist_search(const SkipList* d, int value, unsigned int *nb_operations);
 
+/**
+ *  @brief Search for the presence of several values in a SkipList.
+ *
+ * @par Profile
+ * @parblock
+ *	skiplist_search_batch : SkipList \f$\times\f$ int[] \f$\times\f$ unsigned int \f$\rightarrow\f$ bool[] \f$\times\f$ unsigned int
+ * @endparblock
+ *	@param d the SkipList to search into
+ *	@param values the values to search for
+ *	@param n the number of values
+ *	@param results array of n booleans, results[i] is set to true if values[i] was found, false otherwise
+ *	@param nb_operations The number of tested nodes during the searches
+ *  @return the number of values found.
+ *  @note The values are searched in ascending order, sorting a copy of them if needed. Each search resumes from the nodes
+ *  reached by the previous one, climbing only as many levels as the distance between both values requires.
+ */
+unsigned int skiplist_search_batch(const SkipList* d, const int* values, unsigned int n, bool* results, unsigned int *nb_operations);
+
 /**
  *  @brief Apply an operator on each member of the SkipList, from the begining to the end.
  *
@@ -142,6 +358,22 @@ bool skiplist_search(const SkipList* d, int value, unsigned int *nb_operations);
  */
 void skiplist_map(const SkipList* d, ScanOperator f, void *environment);
 
+/**
+ *  @brief Apply an operator on each member of the SkipList between two bounds, in ascending order.
+ *
+ * @par Profile
+ * @parblock
+ *	skiplist_range : SkipList \f$\times\f$ int \f$\times\f$ int \f$\times\f$ ScanOperator \f$\rightarrow void\f$
+ * @endparblock
+ *	@param d the SkipList to access
+ *	@param lo the lowest value to consider
+ *	@param hi the highest value to consider
+ *	@param f the operator to apply on each value v such that lo \f$\le\f$ v \f$\le\f$ hi
+ *	@param environment user supplied environment for calling the operator.
+ *  @note The first value is reached in O(log n), the cost of the scan is then proportional to the number of values in the range.
+ */
+void skiplist_range(const SkipList* d, int lo, int hi, ScanOperator f, void *environment);
+
 
 /*-----------------------*/
 /* Iterator             */
@@ -154,21 +386,47 @@ void skiplist_map(const SkipList* d, ScanOperator f, void *environment);
 
 typedef enum slit_direction{BACKWARD_ITERATOR, FORWARD_ITERATOR} IteratorDirection;
 /**
- *	@brief Opaque definition of the SkipListIterator abstract data type.
+ *	@brief Definition of the SkipListIterator abstract data type.
+ *
+ *	The fields must only be accessed through the operators, they are declared so that an iterator may be allocated on the
+ *	stack and initialized by skiplist_iterator_init.
+ */
+typedef struct s_SkipListIterator {
+	/// the iterated list.
+	SkipList* skiplist;
+	/// the node designed by the iterator, the sentinel of the list at the end.
+	struct s_Node* current;
+	/// the way the iterator goes.
+	IteratorDirection direction;
+} SkipListIterator;
+
+/**
+ *	@brief Initialization of an iterator, without allocation.
+ * @param it the iterator to initialize
+ * @param d the SkipList to iterate
+ * @param w the way the iterator will go (FORWARD_ITERATOR or BACKWARD_ITERATOR)
+ * @return it, at the beginning of d
+ *	@note the parameter it is modified by side effect and is returned by the function
+ *	@code{.c}
+ *	SkipListIterator it;
+ *	for (skiplist_iterator_init(&it, d, FORWARD_ITERATOR); !skiplist_iterator_end(&it); skiplist_iterator_next(&it))
+ *		...
+ *	@endcode
  */
-typedef struct s_SkipListIterator SkipListIterator;
+SkipListIterator* skiplist_iterator_init(SkipListIterator* it, SkipList* d, IteratorDirection w);
 
 /**
  *	@brief Constructor of an iterator.
  * @param d the SkipList to iterate
  * @param w the way the iterator will go (FORWARD_ITERATOR or BACKWARD_ITERATOR)
  * @return the correcly initialized iterator
+ * @see skiplist_iterator_init
  */
 SkipListIterator* skiplist_iterator_create(SkipList* d, IteratorDirection w);
 
 /**
- *	@brief Destructor of an iterator.
- *  @param it the iterator to delete
+ *	@brief Destructor of an iterator created by skiplist_iterator_create.
+ *  @param it the iterator to delete, set to NULL
  */
 void skiplist_iterator_delete(SkipListIterator** it);
 
@@ -202,6 +460,28 @@ SkipListIterator* skiplist_iterator_next(SkipListIterator* it);
  */
 int skiplist_iterator_value(SkipListIterator* it);
 
+/**
+ *	@brief Move the iterator to a given value, or to the closest one according to its direction.
+ *  @param it the iterator to modify
+ *  @param value the value to seek
+ *	@return the modified iterator, designing the first value greater or equal to value for a FORWARD_ITERATOR,
+ *	the last value lower or equal to value for a BACKWARD_ITERATOR, or at the end if there is no such value.
+ *	@note the parameter it is modified by side effect and is returned by the function
+ *	@note The iterator reaches its position in O(log n) and may then go on in its direction with skiplist_iterator_next.
+ */
+SkipListIterator* skiplist_iterator_seek(SkipListIterator* it, int value);
+
+/**
+ *	@brief Remove the value designed by the iterator from its list and increment the iterator.
+ *  @param it the iterator to modify, that must not be at the end
+ *	@return the modified iterator, designing the value following the removed one according to its direction
+ *	@note the parameter it and its list are modified by side effect and it is returned by the function
+ *	@note The node is unlinked through its backward links, without searching the list, in O(level) on average.
+ *	Other iterators designing the removed value become invalid.
+ *	@see skiplist_remove
+ */
+SkipListIterator* skiplist_iterator_erase(SkipListIterator* it);
+
 
 /** @} */
 
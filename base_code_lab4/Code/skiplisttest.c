@@ -1,8 +1,23 @@
+#ifdef __linux__
+#define _DEFAULT_SOURCE
+#else
+#define _POSIX_C_SOURCE 200809L
+#endif
+
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <time.h>
+#ifdef __linux__
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <sys/ioctl.h>
+#include <linux/perf_event.h>
+#endif
 
 #include "skiplist.h"
+#include "skipmap.h"
+#include "bskiplist.h"
 #include "rng.h"
 
 /**
@@ -22,8 +37,34 @@
  	i : construct the skiplist with data read from file ../Test/test_files/construct_num.txt and search, using an iterator, elements read from file test_files/search_num.txt
  		Print statistics about the searches.
  	r : construct the skiplist with data read from file test_files/construct_num.txt, remove values read from file test_files/remove_num.txt and print the list in reverse order
+ 	p : construct the skiplist with data read from file test_files/construct_num.txt and search repeatedly, without printing them, the elements from file test_files/search_num.txt
+ 		Print the time and, when hardware counters are available, the cache misses per search.
+ 	a : construct the skiplist with data read from file test_files/construct_num.txt, remove values read from file test_files/remove_num.txt and check skiplist_at and skiplist_rank against an iteration of the list
+ 		Print the time per access.
+ 	w : construct the skiplist with data read from file test_files/construct_num.txt and, for each value v read from file test_files/search_num.txt, count the values in [v, v+100] with skiplist_range and with iterators moved by skiplist_iterator_seek
+ 		Print the number of mismatches and the time per range.
+ 	l : construct the skiplist with data read from file test_files/construct_num.txt by successive insertions, then by sorting the data and loading them with skiplist_build_sorted
+ 		Print the time of both constructions and check that skiplist_build_sorted rejects values that are not strictly ascending.
+ 	f : construct the skiplist with data read from file test_files/construct_num.txt and search the elements from file test_files/search_num.txt one by one, then in a single batch with skiplist_search_batch
+ 		Print the number of operations and the time of both searches.
+ 	v : compare the generators of levels : time of a draw, then mean number of operations to search the elements from file test_files/search_num.txt in the skiplist constructed with data read from file test_files/construct_num.txt
+ 	m : construct a SkipMap counting the occurrences of the values read from file test_files/construct_num.txt, erase the values read from file test_files/remove_num.txt and compare its keys with the corresponding skiplist, in both directions
+ 	d : compare the skiplists constructed with data read from file test_files/construct_num.txt with 1, 4 and the maximal number of levels, with the number of levels of the file and with a dynamic number of levels
+ 		Print the time and mean number of operations to search the elements from file test_files/search_num.txt.
+ 	o : construct the skiplist with data read from file test_files/construct_num.txt, save it in a binary file, load it and check that both skiplists have the same nodes, before and after the insertion of the elements from file test_files/search_num.txt
+ 		Print the time of the construction from the text file and of the load of the binary file.
+ 	x : construct a SkipList and a BSkipList with data read from file test_files/construct_num.txt, search in both the elements from file test_files/search_num.txt, then remove the values read from file test_files/remove_num.txt
+ 		Check that both lists hold the same values and print the time and number of operations of each step.
+ 	t : construct the skiplist with data read from file test_files/construct_num.txt, search the elements from file test_files/search_num.txt and remove the values read from file test_files/remove_num.txt
+ 		Print the statistics of the skiplist after the construction and after the removals, then check that the nodes kept for reuse are bounded once all the values are removed.
+ 	u : compute the union, intersection and difference of the skiplists constructed with data read from files test_files/construct_num.txt and test_files/search_num.txt, by successive insertions, searches or removals and by skiplist_union, skiplist_intersection and skiplist_difference
+ 		Check that both results hold the same values and print the time of each computation.
+ 	e : construct the skiplist with data read from file test_files/construct_num.txt and, for each value v read from file test_files/search_num.txt, remove the values in [v, v+100] with skiplist_remove_range, with successive calls to skiplist_remove and with skiplist_iterator_erase
+ 		Check that the lists hold the same values and print the number of removed values and the time of the removals.
+ 	b : benchmark the skiplist on num keys generated in memory, uniformly, sequentially and following a Zipf law, without printing the values
+ 		Print the time per operation and the number of operations per second of the construction, of searches of present and absent keys, of an iteration and of the removal of the keys.
  
- and num is the file number for input.
+ and num is the file number for input, or the number of keys for the benchmark.
  @endcode
  */
 void usage(const char *command) {
@@ -33,7 +74,21 @@ void usage(const char *command) {
 	printf("\ts : construct the skiplist with data read from file test_files/construct_num.txt and search elements from file test_files/search_num..txt\n\t\tPrint statistics about the searches.\n");
 	printf("\ti : construct the skiplist with data read from file test_files/construct_num.txt and search, using an iterator, elements read from file test_files/search_num.txt\n\t\tPrint statistics about the searches.\n");
 	printf("\tr : construct the skiplist with data read from file test_files/construct_num.txt, remove values read from file test_files/remove_num.txt and print the list in reverse order\n");
-	printf("and num is the file number for input\n");
+	printf("\tp : construct the skiplist with data read from file test_files/construct_num.txt and search repeatedly, without printing them, the elements from file test_files/search_num.txt\n\t\tPrint the time and, when hardware counters are available, the cache misses per search.\n");
+	printf("\ta : construct the skiplist with data read from file test_files/construct_num.txt, remove values read from file test_files/remove_num.txt and check skiplist_at and skiplist_rank against an iteration of the list\n\t\tPrint the time per access.\n");
+	printf("\tw : construct the skiplist with data read from file test_files/construct_num.txt and, for each value v read from file test_files/search_num.txt, count the values in [v, v+100] with skiplist_range and with iterators moved by skiplist_iterator_seek\n\t\tPrint the number of mismatches and the time per range.\n");
+	printf("\tl : construct the skiplist with data read from file test_files/construct_num.txt by successive insertions, then by sorting the data and loading them with skiplist_build_sorted\n\t\tPrint the time of both constructions and check that skiplist_build_sorted rejects values that are not strictly ascending.\n");
+	printf("\tf : construct the skiplist with data read from file test_files/construct_num.txt and search the elements from file test_files/search_num.txt one by one, then in a single batch with skiplist_search_batch\n\t\tPrint the number of operations and the time of both searches.\n");
+	printf("\tv : compare the generators of levels : time of a draw, then mean number of operations to search the elements from file test_files/search_num.txt in the skiplist constructed with data read from file test_files/construct_num.txt\n");
+	printf("\tm : construct a SkipMap counting the occurrences of the values read from file test_files/construct_num.txt, erase the values read from file test_files/remove_num.txt and compare its keys with the corresponding skiplist, in both directions\n");
+	printf("\td : compare the skiplists constructed with data read from file test_files/construct_num.txt with 1, 4 and the maximal number of levels, with the number of levels of the file and with a dynamic number of levels\n\t\tPrint the time and mean number of operations to search the elements from file test_files/search_num.txt.\n");
+	printf("\to : construct the skiplist with data read from file test_files/construct_num.txt, save it in a binary file, load it and check that both skiplists have the same nodes, before and after the insertion of the elements from file test_files/search_num.txt\n\t\tPrint the time of the construction from the text file and of the load of the binary file.\n");
+	printf("\tx : construct a SkipList and a BSkipList with data read from file test_files/construct_num.txt, search in both the elements from file test_files/search_num.txt, then remove the values read from file test_files/remove_num.txt\n\t\tCheck that both lists hold the same values and print the time and number of operations of each step.\n");
+	printf("\tt : construct the skiplist with data read from file test_files/construct_num.txt, search the elements from file test_files/search_num.txt and remove the values read from file test_files/remove_num.txt\n\t\tPrint the statistics of the skiplist after the construction and after the removals, then check that the nodes kept for reuse are bounded once all the values are removed.\n");
+	printf("\tu : compute the union, intersection and difference of the skiplists constructed with data read from files test_files/construct_num.txt and test_files/search_num.txt, by successive insertions, searches or removals and by skiplist_union, skiplist_intersection and skiplist_difference\n\t\tCheck that both results hold the same values and print the time of each computation.\n");
+	printf("\te : construct the skiplist with data read from file test_files/construct_num.txt and, for each value v read from file test_files/search_num.txt, remove the values in [v, v+100] with skiplist_remove_range, with successive calls to skiplist_remove and with skiplist_iterator_erase\n\t\tCheck that the lists hold the same values and print the number of removed values and the time of the removals.\n");
+	printf("\tb : benchmark the skiplist on num keys generated in memory, uniformly, sequentially and following a Zipf law, without printing the values\n\t\tPrint the time per operation and the number of operations per second of the construction, of searches of present and absent keys, of an iteration and of the removal of the keys.\n");
+	printf("and num is the file number for input, or the number of keys for the benchmark\n");
 }
 
 /** Return the filename associated with the action to perform and the number of a test.
@@ -248,6 +303,1033 @@ void test_remove(int num){
 	skiplist_delete(&d);
 }
 
+/** Current time in seconds.
+ */
+double now(void) {
+	struct timespec t;
+	clock_gettime(CLOCK_MONOTONIC, &t);
+	return t.tv_sec + t.tv_nsec * 1e-9;
+}
+
+/** Open a counter of the cache misses of the calling process, in user mode.
+ @return the file descriptor of the counter, -1 if hardware counters are not available.
+ */
+int cache_misses_open(void) {
+#ifdef __linux__
+	struct perf_event_attr attr;
+	memset(&attr, 0, sizeof(attr));
+	attr.size = sizeof(attr);
+	attr.type = PERF_TYPE_HARDWARE;
+	attr.config = PERF_COUNT_HW_CACHE_MISSES;
+	attr.disabled = 1;
+	attr.exclude_kernel = 1;
+	attr.exclude_hv = 1;
+	return (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+#else
+	return -1;
+#endif
+}
+
+/** Read the cache misses counter opened by cache_misses_open.
+ */
+long long cache_misses_read(int counter) {
+	long long count = 0;
+#ifdef __linux__
+	if (read(counter, &count, sizeof(count)) != sizeof(count))
+		count = 0;
+#else
+	(void)counter;
+#endif
+	return count;
+}
+
+/** Profiling of the search operator.
+ The searches are repeated until at least one million of them are done.
+ */
+void test_profile_search(int num){
+	SkipList* d = buildlist(num);
+	FILE *input;
+	
+	char *searchfromfile = gettestfilename("search", num);
+	input = fopen(searchfromfile, "r");
+	if (input!=NULL) {
+		unsigned int nb_values = read_uint(input);
+		int* values = malloc(nb_values * sizeof(int));
+		for (unsigned int i=0; i < nb_values; i++)
+			values[i] = read_int(input);
+		unsigned int repeat = 1000000 / nb_values + 1, found = 0, nb_operations = 0;
+
+		int counter = cache_misses_open();
+#ifdef __linux__
+		if (counter >= 0) {
+			ioctl(counter, PERF_EVENT_IOC_RESET, 0);
+			ioctl(counter, PERF_EVENT_IOC_ENABLE, 0);
+		}
+#endif
+		double start = now();
+		for (unsigned int r = 0; r < repeat; ++r)
+			for (unsigned int i=0; i < nb_values; i++)
+				found += skiplist_search(d, values[i], &nb_operations);
+		double elapsed = now() - start;
+		long long misses = (counter >= 0 ? cache_misses_read(counter) : 0);
+
+		double nb_searches = (double)repeat * nb_values;
+		printf("Profile of %.0f searches in a list of %d values (%u found)\n", nb_searches, skiplist_size(d), found);
+		printf("\tTime per search : %.1f ns\n", elapsed * 1e9 / nb_searches);
+		if (counter >= 0) {
+			printf("\tCache misses per search : %.2f\n", misses / nb_searches);
+			close(counter);
+		}
+		else
+			printf("\tCache misses per search : hardware counters not available\n");
+		free(values);
+	} else {
+		printf("Unable to open file %s\n", searchfromfile);
+		free(searchfromfile);
+		exit (1);
+	}
+	free(searchfromfile);
+	fclose(input);
+	skiplist_delete(&d);
+}
+
+/** Test of the positional access operators.
+ */
+void test_positional_access(int num){
+	SkipList* d = buildlist(num);
+	FILE *input;
+	
+	char *removefromfile = gettestfilename("remove", num);
+	input = fopen(removefromfile, "r");
+	if (input!=NULL) {
+		unsigned int nb_values = read_uint(input);
+		for (unsigned int i=0; i < nb_values; i++)
+			skiplist_remove(d, read_int(input));
+
+		unsigned int errors = 0, i = 0;
+		SkipListIterator * it = skiplist_iterator_create(d, FORWARD_ITERATOR);
+		for (it = skiplist_iterator_begin(it) ;!skiplist_iterator_end(it) ; it = skiplist_iterator_next(it), ++i)
+			errors += (skiplist_at(d, i) != skiplist_iterator_value(it) || skiplist_rank(d, skiplist_iterator_value(it)) != i);
+		skiplist_iterator_delete(&it);
+
+		int sum = 0;
+		double start = now();
+		for (i = 0; i < skiplist_size(d); ++i)
+			sum += skiplist_at(d, i);
+		double elapsed = now() - start;
+		printf("Positional access in a list of %d values : %u errors, %.1f ns per access (checksum %d)\n", skiplist_size(d), errors,
+			   elapsed * 1e9 / skiplist_size(d), sum);
+	} else {
+		printf("Unable to open file %s\n", removefromfile);
+		free(removefromfile);
+		exit (1);
+	}
+	free(removefromfile);
+	fclose(input);
+	skiplist_delete(&d);
+}
+
+/** Width of the windows scanned by test_range.
+ */
+#define RANGE_WIDTH 100
+
+void count_values(int value, void* environment) {
+	(void)value;
+	(*(unsigned int*)environment)++;
+}
+
+/** Test of the range scan and of the iterator seek operator.
+ */
+void test_range(int num){
+	SkipList* d = buildlist(num);
+	FILE *input;
+	
+	char *searchfromfile = gettestfilename("search", num);
+	input = fopen(searchfromfile, "r");
+	if (input!=NULL) {
+		unsigned int nb_values = read_uint(input), mismatches = 0, total = 0;
+		SkipListIterator * forward = skiplist_iterator_create(d, FORWARD_ITERATOR);
+		SkipListIterator * backward = skiplist_iterator_create(d, BACKWARD_ITERATOR);
+		double elapsed = 0;
+		for (unsigned int i=0; i < nb_values; i++) {
+			int lo = read_int(input), hi = lo + RANGE_WIDTH;
+			unsigned int in_range = 0, forward_count = 0, backward_count = 0;
+			double start = now();
+			skiplist_range(d, lo, hi, count_values, &in_range);
+			elapsed += now() - start;
+			for (forward = skiplist_iterator_seek(forward, lo); !skiplist_iterator_end(forward) && skiplist_iterator_value(forward) <= hi; forward = skiplist_iterator_next(forward))
+				forward_count++;
+			for (backward = skiplist_iterator_seek(backward, hi); !skiplist_iterator_end(backward) && skiplist_iterator_value(backward) >= lo; backward = skiplist_iterator_next(backward))
+				backward_count++;
+			mismatches += (in_range != forward_count || in_range != backward_count || in_range != skiplist_rank(d, hi+1) - skiplist_rank(d, lo));
+			total += in_range;
+		}
+		printf("Scan of %u ranges of width %d in a list of %d values : %u values, %u mismatches, %.1f ns per range\n", nb_values, RANGE_WIDTH,
+			   skiplist_size(d), total, mismatches, elapsed * 1e9 / nb_values);
+		skiplist_iterator_delete(&forward);
+		skiplist_iterator_delete(&backward);
+	} else {
+		printf("Unable to open file %s\n", searchfromfile);
+		free(searchfromfile);
+		exit (1);
+	}
+	free(searchfromfile);
+	fclose(input);
+	skiplist_delete(&d);
+}
+
+/** Number of constructions timed by test_bulk_load.
+ */
+#define BUILD_REPEAT 100
+
+int compare_int(const void* a, const void* b) {
+	int x = *(const int*)a, y = *(const int*)b;
+	return (x > y) - (x < y);
+}
+
+/** Comparison of the construction by insertion and by bulk load of sorted values.
+ */
+void test_bulk_load(int num){
+	FILE *input;
+	
+	char *constructfromfile = gettestfilename("construct", num);
+	input = fopen(constructfromfile, "r");
+	if (input!=NULL) {
+		int nblevels = read_uint(input);
+		unsigned int nb_values = read_uint(input);
+		int* values = malloc(nb_values * sizeof(int));
+		int* sorted = malloc(nb_values * sizeof(int));
+		for (unsigned int i=0; i < nb_values; i++)
+			values[i] = read_int(input);
+
+		SkipList* inserted = NULL;
+		double start = now();
+		for (int r = 0; r < BUILD_REPEAT; ++r) {
+			if (inserted != NULL)
+				skiplist_delete(&inserted);
+			inserted = skiplist_create(nblevels);
+			for (unsigned int i=0; i < nb_values; i++)
+				skiplist_insert(inserted, values[i]);
+		}
+		double insert_time = (now() - start) / BUILD_REPEAT;
+
+		SkipList* loaded = NULL;
+		unsigned int nb_distinct = 0;
+		double sort_time = 0;
+		start = now();
+		for (int r = 0; r < BUILD_REPEAT; ++r) {
+			if (loaded != NULL)
+				skiplist_delete(&loaded);
+			double sort_start = now();
+			memcpy(sorted, values, nb_values * sizeof(int));
+			qsort(sorted, nb_values, sizeof(int), compare_int);
+			nb_distinct = 0;
+			for (unsigned int i=0; i < nb_values; i++)
+				if (nb_distinct == 0 || sorted[nb_distinct-1] != sorted[i])
+					sorted[nb_distinct++] = sorted[i];
+			sort_time += now() - sort_start;
+			loaded = skiplist_build_sorted(sorted, nb_distinct, nblevels);
+		}
+		double load_time = (now() - start) / BUILD_REPEAT;
+		sort_time /= BUILD_REPEAT;
+
+		bool same = (skiplist_size(inserted) == skiplist_size(loaded));
+		SkipListIterator* it1 = skiplist_iterator_create(inserted, FORWARD_ITERATOR);
+		SkipListIterator* it2 = skiplist_iterator_create(loaded, FORWARD_ITERATOR);
+		for (; same && !skiplist_iterator_end(it1); it1 = skiplist_iterator_next(it1), it2 = skiplist_iterator_next(it2))
+			same = (skiplist_iterator_value(it1) == skiplist_iterator_value(it2));
+		skiplist_iterator_delete(&it1);
+		skiplist_iterator_delete(&it2);
+
+		printf("Construction of a list of %d values from %u values :\n", skiplist_size(loaded), nb_values);
+		printf("\tInsertions : %.3f ms\n", insert_time * 1e3);
+		printf("\tSort and bulk load : %.3f ms (sort %.3f ms, load %.3f ms)\n", load_time * 1e3, sort_time * 1e3, (load_time - sort_time) * 1e3);
+		printf("\t%s content\n", same ? "Same" : "Different");
+
+		/* A duplicated value, then two values out of order, must be rejected. */
+		SkipList* rejected = NULL;
+		if (nb_distinct > 1) {
+			sorted[1] = sorted[0];
+			rejected = skiplist_build_sorted(sorted, nb_distinct, nblevels);
+			sorted[1] = sorted[0] - 1;
+			if (rejected == NULL)
+				rejected = skiplist_build_sorted(sorted, nb_distinct, nblevels);
+		}
+		printf("\t%s of unsorted values\n", rejected == NULL ? "Rejection" : "Construction");
+		if (rejected != NULL)
+			skiplist_delete(&rejected);
+		skiplist_delete(&inserted);
+		skiplist_delete(&loaded);
+		free(values);
+		free(sorted);
+	} else {
+		printf("Unable to open file %s\n", constructfromfile);
+		free(constructfromfile);
+		exit (1);
+	}
+	free(constructfromfile);
+	fclose(input);
+}
+
+/** Comparison of successive searches and of a batched search.
+ */
+void test_search_batch(int num){
+	SkipList* d = buildlist(num);
+	FILE *input;
+	
+	char *searchfromfile = gettestfilename("search", num);
+	input = fopen(searchfromfile, "r");
+	if (input!=NULL) {
+		unsigned int nb_values = read_uint(input);
+		int* values = malloc(nb_values * sizeof(int));
+		bool* results = malloc(nb_values * sizeof(bool));
+		for (unsigned int i=0; i < nb_values; i++)
+			values[i] = read_int(input);
+
+		unsigned int found = 0, nb_operations = 0, mismatches = 0;
+		double start = now();
+		for (unsigned int i=0; i < nb_values; i++)
+			found += skiplist_search(d, values[i], &nb_operations);
+		double elapsed = now() - start;
+		printf("Search %u values in a list of %d values :\n", nb_values, skiplist_size(d));
+		printf("\tOne by one : %u found, %u operations, %.1f ns per search\n", found, nb_operations, elapsed * 1e9 / nb_values);
+
+		nb_operations = 0;
+		start = now();
+		found = skiplist_search_batch(d, values, nb_values, results, &nb_operations);
+		elapsed = now() - start;
+		for (unsigned int i=0; i < nb_values; i++) {
+			unsigned int unused = 0;
+			mismatches += (results[i] != skiplist_search(d, values[i], &unused));
+		}
+		printf("\tBatch : %u found, %u operations, %.1f ns per search, %u mismatches\n", found, nb_operations, elapsed * 1e9 / nb_values, mismatches);
+		free(values);
+		free(results);
+	} else {
+		printf("Unable to open file %s\n", searchfromfile);
+		free(searchfromfile);
+		exit (1);
+	}
+	free(searchfromfile);
+	fclose(input);
+	skiplist_delete(&d);
+}
+
+/** Number of values drawn to time a generator.
+ */
+#define NB_DRAWS 10000000
+
+/** Comparison of the generators of levels.
+ */
+void test_level_generators(int num){
+	FILE *input;
+	
+	char *constructfromfile = gettestfilename("construct", num);
+	char *searchfromfile = gettestfilename("search", num);
+	input = fopen(constructfromfile, "r");
+	FILE *search = fopen(searchfromfile, "r");
+	if (input!=NULL && search!=NULL) {
+		int nblevels = read_uint(input);
+		unsigned int nb_values = read_uint(input);
+		int* values = malloc(nb_values * sizeof(int));
+		for (unsigned int i=0; i < nb_values; i++)
+			values[i] = read_int(input);
+		unsigned int nb_searches = read_uint(search);
+		int* searches = malloc(nb_searches * sizeof(int));
+		for (unsigned int i=0; i < nb_searches; i++)
+			searches[i] = read_int(search);
+
+		const char* names[] = {"LCG48, p = 1/2", "splitmix64, p = 1/2", "splitmix64, p = 1/4"};
+		RNG generators[] = {rng_initialize(0, nblevels), rng_initialize_geometric(0, nblevels, 1), rng_initialize_geometric(0, nblevels, 2)};
+		printf("Generators of %d levels, list of %u values, %u searches :\n", nblevels, nb_values, nb_searches);
+		for (int g = 0; g < 3; ++g) {
+			RNG rng = generators[g];
+			unsigned long long sum = 0;
+			double start = now();
+			for (int i = 0; i < NB_DRAWS; ++i)
+				sum += rng_get_value(&rng);
+			double elapsed = now() - start;
+
+			SkipList* d = skiplist_create_with_rng(generators[g]);
+			for (unsigned int i=0; i < nb_values; i++)
+				skiplist_insert(d, values[i]);
+			unsigned int nb_operations = 0;
+			for (unsigned int i=0; i < nb_searches; i++)
+				skiplist_search(d, searches[i], &nb_operations);
+			printf("\t%-22s : %5.2f ns per draw, mean level %.3f, mean number of operations %.2f\n", names[g], elapsed * 1e9 / NB_DRAWS,
+				   (double)sum / NB_DRAWS + 1, (double)nb_operations / nb_searches);
+			skiplist_delete(&d);
+		}
+		free(values);
+		free(searches);
+	} else {
+		printf("Unable to open file %s or %s\n", constructfromfile, searchfromfile);
+		free(constructfromfile);
+		free(searchfromfile);
+		exit (1);
+	}
+	free(constructfromfile);
+	free(searchfromfile);
+	fclose(input);
+	fclose(search);
+}
+
+/** Comparison of fixed and dynamic numbers of levels.
+ */
+void test_dynamic_levels(int num){
+	FILE *input;
+	
+	char *constructfromfile = gettestfilename("construct", num);
+	char *searchfromfile = gettestfilename("search", num);
+	input = fopen(constructfromfile, "r");
+	FILE *search = fopen(searchfromfile, "r");
+	if (input!=NULL && search!=NULL) {
+		int file_levels = read_uint(input);
+		unsigned int nb_values = read_uint(input);
+		int* values = malloc(nb_values * sizeof(int));
+		for (unsigned int i=0; i < nb_values; i++)
+			values[i] = read_int(input);
+		unsigned int nb_searches = read_uint(search);
+		int* searches = malloc(nb_searches * sizeof(int));
+		for (unsigned int i=0; i < nb_searches; i++)
+			searches[i] = read_int(search);
+
+		int nblevels[] = {1, 4, file_levels, SKIPLIST_MAX_LEVELS, SKIPLIST_DYNAMIC_LEVELS};
+		printf("Search %u values in a list built from %u values :\n", nb_searches, nb_values);
+		for (int l = 0; l < 5; ++l) {
+			double start = now();
+			SkipList* d = skiplist_create(nblevels[l]);
+			for (unsigned int i=0; i < nb_values; i++)
+				skiplist_insert(d, values[i]);
+			double build_time = now() - start;
+			unsigned int nb_operations = 0;
+			start = now();
+			for (unsigned int i=0; i < nb_searches; i++)
+				skiplist_search(d, searches[i], &nb_operations);
+			double search_time = now() - start;
+			if (nblevels[l] == SKIPLIST_DYNAMIC_LEVELS)
+				printf("\tdynamic levels : ");
+			else
+				printf("\t%2d levels      : ", nblevels[l]);
+			printf("construction %.3f ms, %.1f ns per search, mean number of operations %.2f\n", build_time * 1e3,
+				   search_time * 1e9 / nb_searches, (double)nb_operations / nb_searches);
+			skiplist_delete(&d);
+		}
+		free(values);
+		free(searches);
+	} else {
+		printf("Unable to open file %s or %s\n", constructfromfile, searchfromfile);
+		free(constructfromfile);
+		free(searchfromfile);
+		exit (1);
+	}
+	free(constructfromfile);
+	free(searchfromfile);
+	fclose(input);
+	fclose(search);
+}
+
+/** Values read from a test file.
+ */
+typedef struct s_TestValues {
+	unsigned int nb_values;
+	int* values;
+} TestValues;
+
+/** Read the values of a test file, after the number of levels for a construct file.
+ */
+TestValues read_test_values(const char* action, int num, int* nblevels) {
+	TestValues v;
+	char *filename = gettestfilename(action, num);
+	FILE *input = fopen(filename, "r");
+	if (input == NULL) {
+		printf("Unable to open file %s\n", filename);
+		free(filename);
+		exit (1);
+	}
+	if (nblevels != NULL)
+		*nblevels = read_uint(input);
+	v.nb_values = read_uint(input);
+	v.values = malloc(v.nb_values * sizeof(int));
+	for (unsigned int i=0; i < v.nb_values; i++)
+		v.values[i] = read_int(input);
+	free(filename);
+	fclose(input);
+	return v;
+}
+
+/** Append a value to a TestValues whose array is large enough.
+ */
+void append_value(int value, void* environment) {
+	TestValues* v = (TestValues*)environment;
+	v->values[v->nb_values++] = value;
+}
+
+/** Compare two skiplists : same values and same number of operations to search each of them and each of the values in a given array.
+ */
+bool same_skiplists(const SkipList* d1, const SkipList* d2, const int* values, unsigned int nb_values) {
+	bool same = (skiplist_size(d1) == skiplist_size(d2));
+	for (unsigned int i = 0; same && i < skiplist_size(d1); ++i) {
+		unsigned int op1 = 0, op2 = 0;
+		same = (skiplist_at(d1, i) == skiplist_at(d2, i)
+				&& skiplist_search(d1, skiplist_at(d1, i), &op1) && skiplist_search(d2, skiplist_at(d2, i), &op2) && op1 == op2);
+	}
+	for (unsigned int i = 0; same && i < nb_values; ++i) {
+		unsigned int op1 = 0, op2 = 0;
+		same = (skiplist_search(d1, values[i], &op1) == skiplist_search(d2, values[i], &op2) && op1 == op2);
+	}
+	return same;
+}
+
+/** Save a skiplist in a binary file and load it back, exiting if one of them fails.
+ */
+SkipList* save_and_load(const SkipList* d, double* load_time) {
+	const char* snapshot = "skiplist_snapshot.bin";
+	if (!skiplist_save(d, snapshot)) {
+		printf("Unable to save the skiplist in %s\n", snapshot);
+		exit(1);
+	}
+	double start = now();
+	SkipList* loaded = skiplist_load(snapshot);
+	*load_time = now() - start;
+	remove(snapshot);
+	if (loaded == NULL) {
+		printf("Unable to load the skiplist from %s\n", snapshot);
+		exit(1);
+	}
+	return loaded;
+}
+
+/** Check that a skiplist and its loaded copy have the same nodes, before and after the insertion of the same values in both.
+ */
+void check_loaded(SkipList* d, SkipList* loaded, const TestValues* values) {
+	printf("\t%s nodes after loading\n", same_skiplists(d, loaded, values->values, values->nb_values) ? "Same" : "Different");
+	for (unsigned int i=0; i < values->nb_values; i++) {
+		skiplist_insert(d, values->values[i]);
+		skiplist_insert(loaded, values->values[i]);
+	}
+	printf("\t%s nodes after inserting %u values\n", same_skiplists(d, loaded, values->values, values->nb_values) ? "Same" : "Different",
+		   values->nb_values);
+}
+
+/** Test of the binary save and load of a skiplist.
+ */
+void test_save_load(int num){
+	double start = now();
+	SkipList* d = buildlist(num);
+	double build_time = now() - start;
+	TestValues search = read_test_values("search", num, NULL);
+	double load_time;
+	SkipList* loaded = save_and_load(d, &load_time);
+	printf("Skiplist of %d values :\n", skiplist_size(d));
+	printf("\tConstruction from the text file : %.3f ms\n", build_time * 1e3);
+	printf("\tLoad of the binary file : %.3f ms\n", load_time * 1e3);
+	check_loaded(d, loaded, &search);
+	skiplist_delete(&loaded);
+	skiplist_delete(&d);
+
+	/* The generator of a promotion probability other than 1/2 must draw the same levels after the load. */
+	int nblevels;
+	TestValues construct = read_test_values("construct", num, &nblevels);
+	d = skiplist_create_with_rng(rng_initialize_geometric(1, nblevels, 2));
+	for (unsigned int i=0; i < construct.nb_values; i++)
+		skiplist_insert(d, construct.values[i]);
+	loaded = save_and_load(d, &load_time);
+	printf("Skiplist of %d values with a promotion probability of 1/4 :\n", skiplist_size(d));
+	check_loaded(d, loaded, &search);
+	skiplist_delete(&loaded);
+	skiplist_delete(&d);
+	free(construct.values);
+	free(search.values);
+}
+
+/** Check that a SkipList and a BSkipList hold the same values.
+ */
+bool same_values(const SkipList* d, const BSkipList* b) {
+	if (skiplist_size(d) != bskiplist_size(b))
+		return false;
+	TestValues v1 = {0, malloc((skiplist_size(d) + 1) * sizeof(int))};
+	TestValues v2 = {0, malloc((skiplist_size(d) + 1) * sizeof(int))};
+	skiplist_map(d, append_value, &v1);
+	bskiplist_map(b, append_value, &v2);
+	bool same = (v1.nb_values == v2.nb_values && memcmp(v1.values, v2.values, v1.nb_values * sizeof(int)) == 0);
+	free(v1.values);
+	free(v2.values);
+	return same;
+}
+
+/** Comparison of the SkipList and of the BSkipList.
+ */
+void test_bskiplist(int num){
+	int nblevels;
+	TestValues construct = read_test_values("construct", num, &nblevels);
+	TestValues search = read_test_values("search", num, NULL);
+	TestValues removed = read_test_values("remove", num, NULL);
+
+	double start = now();
+	SkipList* d = skiplist_create(nblevels);
+	for (unsigned int i=0; i < construct.nb_values; i++)
+		skiplist_insert(d, construct.values[i]);
+	double d_build = now() - start;
+	start = now();
+	BSkipList* b = bskiplist_create(nblevels);
+	for (unsigned int i=0; i < construct.nb_values; i++)
+		bskiplist_insert(b, construct.values[i]);
+	double b_build = now() - start;
+	bool same = same_values(d, b);
+
+	unsigned int d_found = 0, b_found = 0, d_operations = 0, b_operations = 0;
+	start = now();
+	for (unsigned int i=0; i < search.nb_values; i++)
+		d_found += skiplist_search(d, search.values[i], &d_operations);
+	double d_search = now() - start;
+	start = now();
+	for (unsigned int i=0; i < search.nb_values; i++)
+		b_found += bskiplist_search(b, search.values[i], &b_operations);
+	double b_search = now() - start;
+
+	start = now();
+	for (unsigned int i=0; i < removed.nb_values; i++)
+		skiplist_remove(d, removed.values[i]);
+	double d_remove = now() - start;
+	start = now();
+	for (unsigned int i=0; i < removed.nb_values; i++)
+		bskiplist_remove(b, removed.values[i]);
+	double b_remove = now() - start;
+	same = same && same_values(d, b);
+
+	printf("%-10s %8s %14s %10s %14s %14s %8s\n", "", "values", "construction", "found", "ns per search", "operations", "removal");
+	printf("%-10s %8u %11.3f ms %10u %14.1f %14.2f %5.3f ms\n", "SkipList", skiplist_size(d), d_build * 1e3, d_found,
+		   d_search * 1e9 / search.nb_values, (double)d_operations / search.nb_values, d_remove * 1e3);
+	printf("%-10s %8u %11.3f ms %10u %14.1f %14.2f %5.3f ms\n", "BSkipList", bskiplist_size(b), b_build * 1e3, b_found,
+		   b_search * 1e9 / search.nb_values, (double)b_operations / search.nb_values, b_remove * 1e3);
+	printf("%s values\n", same && d_found == b_found ? "Same" : "Different");
+	skiplist_delete(&d);
+	bskiplist_delete(&b);
+	free(construct.values);
+	free(search.values);
+	free(removed.values);
+}
+
+/** Print the statistics of a skiplist.
+ */
+void print_stats(const SkipList* d) {
+	SkipListStats stats;
+	skiplist_stats(d, &stats);
+	printf("Skiplist of %u values, %d populated levels out of %d :\n", stats.size, stats.levels, stats.nblevels);
+	printf("\tLevel  Nodes  Population\n");
+	for (int i = 0; i < stats.levels; ++i)
+		printf("\t%5d %6u %11u\n", i+1, stats.nodes_by_level[i], stats.population[i]);
+	printf("\tSearch length : mean %.2f, max %u\n", stats.mean_search_length, stats.max_search_length);
+	printf("\tMemory : %lu bytes, %.2f bytes per value, %lu bytes of %u nodes kept for reuse\n", (unsigned long)stats.bytes,
+		   stats.bytes_per_element, (unsigned long)stats.pool_bytes, stats.pool_nodes);
+	if (stats.instrumented) {
+		printf("\tInsertions : %llu calls, %llu probes\n", stats.insert_calls, stats.insert_probes);
+		printf("\tRemovals : %llu calls, %llu probes\n", stats.remove_calls, stats.remove_probes);
+		printf("\tSearches : %llu calls, %llu probes\n", stats.search_calls, stats.search_probes);
+	}
+}
+
+/** Statistics of a skiplist.
+ */
+void test_stats(int num){
+	SkipList* d = buildlist(num);
+	TestValues search = read_test_values("search", num, NULL);
+	TestValues removed = read_test_values("remove", num, NULL);
+	for (unsigned int i=0; i < search.nb_values; i++) {
+		unsigned int nb_operations = 0;
+		skiplist_search(d, search.values[i], &nb_operations);
+	}
+	print_stats(d);
+	for (unsigned int i=0; i < removed.nb_values; i++)
+		skiplist_remove(d, removed.values[i]);
+	print_stats(d);
+
+	/* Once the list is empty, its pools must be back to their minimal size. */
+	while (skiplist_size(d) > 0)
+		skiplist_remove(d, skiplist_at(d, 0));
+	SkipListStats stats;
+	skiplist_stats(d, &stats);
+	printf("Pool of %u nodes after removing all the values : %s\n", stats.pool_nodes,
+		   stats.pool_nodes <= (unsigned int)stats.nblevels * SKIPLIST_POOL_MIN_NODES ? "bounded" : "unbounded");
+	skiplist_delete(&d);
+	free(search.values);
+	free(removed.values);
+}
+
+/** Check that two skiplists hold the same values, by position and by iterating them backward.
+ */
+bool same_contents(const SkipList* d1, SkipList* d2) {
+	bool same = (skiplist_size(d1) == skiplist_size(d2));
+	for (unsigned int i = 0; same && i < skiplist_size(d1); ++i)
+		same = (skiplist_at(d1, i) == skiplist_at(d2, i));
+	SkipListIterator* it = skiplist_iterator_create(d2, BACKWARD_ITERATOR);
+	for (unsigned int i = skiplist_size(d1); same && i > 0; --i, it = skiplist_iterator_next(it))
+		same = (!skiplist_iterator_end(it) && skiplist_iterator_value(it) == skiplist_at(d1, i-1));
+	same = same && skiplist_iterator_end(it);
+	skiplist_iterator_delete(&it);
+	return same;
+}
+
+/** Build a skiplist with nblevels levels by successive insertions of values.
+ */
+SkipList* insert_values(const TestValues* values, int nblevels) {
+	SkipList* d = skiplist_create(nblevels);
+	for (unsigned int i=0; i < values->nb_values; i++)
+		skiplist_insert(d, values->values[i]);
+	return d;
+}
+
+/** Comparison of the set operations by successive operations and by a linear walk of both lists.
+ */
+void test_set_operations(int num){
+	int nblevels;
+	TestValues construct = read_test_values("construct", num, &nblevels);
+	TestValues search = read_test_values("search", num, NULL);
+	const char* names[] = {"Union", "Intersection", "Difference"};
+	for (int operation = 0; operation < 3; ++operation) {
+		SkipList* d = insert_values(&construct, nblevels);
+		SkipList* e = insert_values(&search, nblevels);
+		double start = now();
+		SkipList* expected = d;
+		if (operation == 0) {
+			for (unsigned int i=0; i < search.nb_values; i++)
+				skiplist_insert(expected, search.values[i]);
+		} else if (operation == 1) {
+			expected = skiplist_create(nblevels);
+			for (unsigned int i=0; i < construct.nb_values; i++) {
+				unsigned int nb_operations = 0;
+				if (skiplist_search(e, construct.values[i], &nb_operations))
+					skiplist_insert(expected, construct.values[i]);
+			}
+		} else {
+			for (unsigned int i=0; i < search.nb_values; i++)
+				skiplist_remove(expected, search.values[i]);
+		}
+		double successive_time = now() - start;
+		if (expected != d)
+			skiplist_delete(&d);
+		skiplist_delete(&e);
+
+		d = insert_values(&construct, nblevels);
+		e = insert_values(&search, nblevels);
+		start = now();
+		if (operation == 0)
+			d = skiplist_union(d, &e);
+		else if (operation == 1)
+			d = skiplist_intersection(d, &e);
+		else
+			d = skiplist_difference(d, &e);
+		double linear_time = now() - start;
+		printf("%s of %u values : %s values, successive operations %.3f ms, linear walk %.3f ms\n", names[operation],
+			   skiplist_size(d), same_contents(expected, d) ? "same" : "different", successive_time * 1e3, linear_time * 1e3);
+		skiplist_delete(&d);
+		skiplist_delete(&expected);
+	}
+
+	/* A list combined with itself. */
+	SkipList* expected = insert_values(&construct, nblevels);
+	SkipList* d = insert_values(&construct, nblevels);
+	SkipList* e = d;
+	bool same = (skiplist_union(d, &e) == d && e == NULL && same_contents(expected, d));
+	e = d;
+	same = same && skiplist_intersection(d, &e) == d && e == NULL && same_contents(expected, d);
+	e = d;
+	same = same && skiplist_difference(d, &e) == d && e == NULL && skiplist_size(d) == 0;
+	printf("Operations of a list with itself : %s results\n", same ? "expected" : "unexpected");
+	skiplist_delete(&d);
+	skiplist_delete(&expected);
+	free(construct.values);
+	free(search.values);
+}
+
+/** Three copies of a list, from which the same ranges are removed by skiplist_remove_range, by successive removals and by a
+ sweep of an iterator, with the number of removed values and the time of each way.
+ */
+typedef struct s_RangeRemovals {
+	SkipList* lists[3];
+	unsigned int removed[3];
+	double time[3];
+	/// values of a range, found by skiplist_range for the successive removals.
+	TestValues range;
+} RangeRemovals;
+
+/** Build the three copies of the list of the values of construct.
+ */
+RangeRemovals range_removals_create(const TestValues* construct, int nblevels) {
+	RangeRemovals r;
+	for (int i = 0; i < 3; ++i) {
+		r.lists[i] = insert_values(construct, nblevels);
+		r.removed[i] = 0;
+		r.time[i] = 0;
+	}
+	r.range.nb_values = 0;
+	r.range.values = malloc((skiplist_size(r.lists[0]) + 1) * sizeof(int));
+	return r;
+}
+
+/** Remove the values of [lo, hi] from the three lists, the iterator going backward from hi or forward from lo.
+ The time of each way includes the search of the beginning of the range.
+ */
+void range_removals_remove(RangeRemovals* r, int lo, int hi, bool backward) {
+	double start = now();
+	r->removed[0] += skiplist_remove_range(r->lists[0], lo, hi);
+	r->time[0] += now() - start;
+
+	start = now();
+	r->range.nb_values = 0;
+	skiplist_range(r->lists[1], lo, hi, append_value, &(r->range));
+	for (unsigned int j=0; j < r->range.nb_values; j++)
+		skiplist_remove(r->lists[1], r->range.values[j]);
+	r->time[1] += now() - start;
+	r->removed[1] += r->range.nb_values;
+
+	SkipListIterator it;
+	start = now();
+	if (!backward) {
+		skiplist_iterator_seek(skiplist_iterator_init(&it, r->lists[2], FORWARD_ITERATOR), lo);
+		for (; !skiplist_iterator_end(&it) && skiplist_iterator_value(&it) <= hi; ++(r->removed[2]))
+			skiplist_iterator_erase(&it);
+	} else {
+		skiplist_iterator_seek(skiplist_iterator_init(&it, r->lists[2], BACKWARD_ITERATOR), hi);
+		for (; !skiplist_iterator_end(&it) && skiplist_iterator_value(&it) >= lo; ++(r->removed[2]))
+			skiplist_iterator_erase(&it);
+	}
+	r->time[2] += now() - start;
+}
+
+/** Print the results of the removals, check that the three lists are the same and delete them.
+ */
+void range_removals_delete(RangeRemovals* r) {
+	printf("\t%u values removed, %u expected, %u erased, %s values\n", r->removed[0], r->removed[1], r->removed[2],
+		   same_contents(r->lists[1], r->lists[0]) && same_contents(r->lists[1], r->lists[2]) ? "same" : "different");
+	printf("\tskiplist_remove_range : %.3f ms\n", r->time[0] * 1e3);
+	printf("\tskiplist_range and successive removals : %.3f ms\n", r->time[1] * 1e3);
+	printf("\tskiplist_iterator_erase : %.3f ms\n", r->time[2] * 1e3);
+	for (int i = 0; i < 3; ++i)
+		skiplist_delete(&(r->lists[i]));
+	free(r->range.values);
+}
+
+/** Comparison of the removal of ranges of values by skiplist_remove_range, by successive removals and by a sweep of an iterator.
+ The ranges start at the values of the search file, most of them are empty once the list is drained. Then, on a new list for
+ each width, one range out of two of a width holding about 10, 100 or 1000 values is removed, halving the list.
+ */
+void test_remove_range(int num){
+	int nblevels;
+	TestValues construct = read_test_values("construct", num, &nblevels);
+	TestValues search = read_test_values("search", num, NULL);
+
+	RangeRemovals r = range_removals_create(&construct, nblevels);
+	unsigned int size = skiplist_size(r.lists[0]);
+	printf("Removal of %u ranges of width %d from a list of %u values :\n", search.nb_values, RANGE_WIDTH, size);
+	for (unsigned int i=0; i < search.nb_values; i++)
+		range_removals_remove(&r, search.values[i], search.values[i] + RANGE_WIDTH, i % 2 == 1);
+	range_removals_delete(&r);
+
+	for (unsigned int count = 10; count <= 1000 && size > 0; count *= 10) {
+		r = range_removals_create(&construct, nblevels);
+		long long first = skiplist_at(r.lists[0], 0), last = skiplist_at(r.lists[0], size - 1);
+		long long width = (last - first + 1) * count / size;
+		if (width < 1)
+			width = 1;
+		printf("Removal of one range out of two of width %lld, about %u values, from a list of %u values :\n", width, count, size);
+		for (long long lo = first; lo <= last; lo += 2 * width)
+			range_removals_remove(&r, (int)lo, (int)(lo + width - 1 < last ? lo + width - 1 : last), (lo / (2 * width)) % 2 == 1);
+		range_removals_delete(&r);
+	}
+	free(construct.values);
+	free(search.values);
+}
+
+/** Distributions of the keys generated by the benchmark.
+ */
+typedef enum e_KeyDistribution {UNIFORM_KEYS, SEQUENTIAL_KEYS, ZIPF_KEYS} KeyDistribution;
+
+/** Keys of the benchmark are even, so that adding one to a key gives an absent key. They are lower than 2 * BENCHMARK_KEY_RANGE,
+ a prime number, so that the scrambling of the ranks of the Zipf law is a bijection.
+ */
+#define BENCHMARK_KEY_RANGE 1000000007U
+
+/** Next value of a splitmix64 generator, so that the generated keys do not depend on the C library.
+ */
+unsigned long long benchmark_random(unsigned long long* state) {
+	unsigned long long z = (*state += 0x9E3779B97F4A7C15ULL);
+	z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+	z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+	return z ^ (z >> 31);
+}
+
+/** Generate nb_keys keys of a distribution. The Zipf law, of exponent 1, draws ranks among nb_keys, scattered over the range of the keys.
+ */
+TestValues generate_keys(KeyDistribution distribution, unsigned int nb_keys) {
+	TestValues v = {nb_keys, malloc(nb_keys * sizeof(int))};
+	unsigned long long state = 0;
+	double* cumulated = NULL;
+	if (distribution == ZIPF_KEYS) {
+		cumulated = malloc(nb_keys * sizeof(double));
+		double sum = 0;
+		for (unsigned int r = 0; r < nb_keys; ++r)
+			cumulated[r] = (sum += 1.0 / (r + 1));
+	}
+	for (unsigned int i = 0; i < nb_keys; ++i) {
+		unsigned long long key;
+		if (distribution == UNIFORM_KEYS)
+			key = benchmark_random(&state) % BENCHMARK_KEY_RANGE;
+		else if (distribution == SEQUENTIAL_KEYS)
+			key = i;
+		else {
+			double u = (benchmark_random(&state) >> 11) * 0x1.0p-53 * cumulated[nb_keys - 1];
+			unsigned int lo = 0, hi = nb_keys - 1;
+			while (lo < hi) {
+				unsigned int middle = lo + (hi - lo) / 2;
+				if (cumulated[middle] < u)
+					lo = middle + 1;
+				else
+					hi = middle;
+			}
+			key = (lo * 2654435761ULL) % BENCHMARK_KEY_RANGE;
+		}
+		v.values[i] = (int)(2 * key);
+	}
+	free(cumulated);
+	return v;
+}
+
+/** Print a line of the benchmark : time per operation and operations per second.
+ */
+void print_benchmark(const char* distribution, const char* operation, unsigned int nb_operations, double time) {
+	printf("%-11s %-12s %10u %10.1f %12.0f\n", distribution, operation, nb_operations, time * 1e9 / nb_operations, nb_operations / time);
+}
+
+/** Benchmark of the skiplist on keys generated in memory.
+ */
+void test_benchmark(int nb_keys){
+	if (nb_keys <= 0) {
+		printf("The number of keys must be positive\n");
+		exit (1);
+	}
+	const char* names[] = {"uniform", "sequential", "zipf"};
+	printf("%-11s %-12s %10s %10s %12s\n", "keys", "operation", "operations", "ns/op", "ops/s");
+	for (int distribution = UNIFORM_KEYS; distribution <= ZIPF_KEYS; ++distribution) {
+		TestValues keys = generate_keys((KeyDistribution)distribution, nb_keys);
+		SkipList* d = skiplist_create(SKIPLIST_DYNAMIC_LEVELS);
+		double start = now();
+		for (unsigned int i = 0; i < keys.nb_values; ++i)
+			skiplist_insert(d, keys.values[i]);
+		print_benchmark(names[distribution], "insert", keys.nb_values, now() - start);
+
+		unsigned int found = 0, nb_operations = 0;
+		start = now();
+		for (unsigned int i = 0; i < keys.nb_values; ++i)
+			found += skiplist_search(d, keys.values[i], &nb_operations);
+		print_benchmark(names[distribution], "search hit", keys.nb_values, now() - start);
+		start = now();
+		for (unsigned int i = 0; i < keys.nb_values; ++i)
+			found += skiplist_search(d, keys.values[i] + 1, &nb_operations);
+		print_benchmark(names[distribution], "search miss", keys.nb_values, now() - start);
+
+		unsigned int visited = 0;
+		SkipListIterator* it = skiplist_iterator_create(d, FORWARD_ITERATOR);
+		start = now();
+		for (; !skiplist_iterator_end(it); it = skiplist_iterator_next(it))
+			visited += (skiplist_iterator_value(it) % 2 == 0);
+		print_benchmark(names[distribution], "iterate", visited, now() - start);
+		skiplist_iterator_delete(&it);
+
+		unsigned int size = skiplist_size(d);
+		start = now();
+		for (unsigned int i = 0; i < keys.nb_values; ++i)
+			skiplist_remove(d, keys.values[i]);
+		print_benchmark(names[distribution], "remove", keys.nb_values, now() - start);
+
+		/* The results are checked, which also keeps the compiler from removing the timed loops. */
+		if (found != keys.nb_values || visited != size || skiplist_size(d) != 0)
+			printf("%s : unexpected results, %u keys found, %u keys visited out of %u, size %u after removal\n", names[distribution],
+				   found, visited, size, skiplist_size(d));
+		skiplist_delete(&d);
+		free(keys.values);
+	}
+}
+
+SKIPMAP_DEFINE(occurrences, int, unsigned int, skipmap_compare_int)
+
+/** Compare the keys of a SkipMap of int keys to the values of a SkipList, in a given direction.
+ */
+bool same_keys(SkipMap* m, SkipList* d, IteratorDirection w) {
+	bool same = (skipmap_size(m) == skiplist_size(d));
+	SkipMapIterator* mit = skipmap_iterator_create(m, w);
+	SkipListIterator* dit = skiplist_iterator_create(d, w);
+	for (; same && !skipmap_iterator_end(mit); mit = skipmap_iterator_next(mit), dit = skiplist_iterator_next(dit))
+		same = (occurrences_iterator_key(mit) == skiplist_iterator_value(dit));
+	skipmap_iterator_delete(&mit);
+	skiplist_iterator_delete(&dit);
+	return same;
+}
+
+/** Put a value with one occurrence in the SkipMap given as environment.
+ */
+void put_occurrence(int value, void* environment) {
+	occurrences_put((SkipMap*)environment, value, 1);
+}
+
+/** Test of the SkipMap.
+ */
+void test_skipmap(int num){
+	SkipList* d = buildlist(num);
+	FILE *input;
+	
+	char *constructfromfile = gettestfilename("construct", num);
+	char *removefromfile = gettestfilename("remove", num);
+	input = fopen(constructfromfile, "r");
+	FILE *remove = fopen(removefromfile, "r");
+	if (input!=NULL && remove!=NULL) {
+		SkipMap* m = occurrences_create(read_uint(input));
+		unsigned int nb_values = read_uint(input);
+		for (unsigned int i=0; i < nb_values; i++) {
+			int value = read_int(input);
+			unsigned int* count = occurrences_get(m, value);
+			if (count != NULL)
+				(*count)++;
+			else
+				occurrences_put(m, value, 1);
+		}
+		unsigned int total = 0;
+		SkipMapIterator* it = skipmap_iterator_create(m, FORWARD_ITERATOR);
+		for (; !skipmap_iterator_end(it); it = skipmap_iterator_next(it))
+			total += *occurrences_iterator_value(it);
+		skipmap_iterator_delete(&it);
+		printf("SkipMap of %u keys counting %u values : %s keys as the skiplist\n", skipmap_size(m), total,
+			   same_keys(m, d, FORWARD_ITERATOR) && same_keys(m, d, BACKWARD_ITERATOR) ? "same" : "different");
+
+		unsigned int nb_removed = read_uint(remove), erased = 0;
+		for (unsigned int i=0; i < nb_removed; i++) {
+			int value = read_int(remove);
+			erased += occurrences_erase(m, value);
+			skiplist_remove(d, value);
+		}
+		printf("SkipMap of %u keys after erasing %u keys : %s keys as the skiplist\n", skipmap_size(m), erased,
+			   same_keys(m, d, FORWARD_ITERATOR) && same_keys(m, d, BACKWARD_ITERATOR) ? "same" : "different");
+		skipmap_delete(&m);
+
+		m = occurrences_create(SKIPLIST_DYNAMIC_LEVELS);
+		skiplist_map(d, put_occurrence, m);
+		printf("SkipMap of %u keys with the maximal number of levels : %s keys as the skiplist\n", skipmap_size(m),
+			   same_keys(m, d, FORWARD_ITERATOR) && same_keys(m, d, BACKWARD_ITERATOR) ? "same" : "different");
+		skipmap_delete(&m);
+	} else {
+		printf("Unable to open file %s or %s\n", constructfromfile, removefromfile);
+		free(constructfromfile);
+		free(removefromfile);
+		exit (1);
+	}
+	free(constructfromfile);
+	free(removefromfile);
+	fclose(input);
+	fclose(remove);
+	skiplist_delete(&d);
+}
+
 /** Function you ca use to generate dataset for testing.
  */
 void generate(int nbvalues);
@@ -271,6 +1353,48 @@ int main(int argc, const char *argv[]){
 		case 'r' :
 			test_remove(atoi(argv[2]));
 			break;
+		case 'p' :
+			test_profile_search(atoi(argv[2]));
+			break;
+		case 'a' :
+			test_positional_access(atoi(argv[2]));
+			break;
+		case 'w' :
+			test_range(atoi(argv[2]));
+			break;
+		case 'l' :
+			test_bulk_load(atoi(argv[2]));
+			break;
+		case 'f' :
+			test_search_batch(atoi(argv[2]));
+			break;
+		case 'v' :
+			test_level_generators(atoi(argv[2]));
+			break;
+		case 'm' :
+			test_skipmap(atoi(argv[2]));
+			break;
+		case 'd' :
+			test_dynamic_levels(atoi(argv[2]));
+			break;
+		case 'o' :
+			test_save_load(atoi(argv[2]));
+			break;
+		case 'x' :
+			test_bskiplist(atoi(argv[2]));
+			break;
+		case 't' :
+			test_stats(atoi(argv[2]));
+			break;
+		case 'u' :
+			test_set_operations(atoi(argv[2]));
+			break;
+		case 'e' :
+			test_remove_range(atoi(argv[2]));
+			break;
+		case 'b' :
+			test_benchmark(atoi(argv[2]));
+			break;
 		case 'g' :
 			generate(atoi(argv[2]));
 			break;
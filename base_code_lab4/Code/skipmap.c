@@ -0,0 +1,185 @@
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "skipmap.h"
+#include "rng.h"
+
+/* The search, insertion and removal follow the ones of skiplist.c, the keys being compared by the comparator of the map.
+   The features of skiplist.c that are not carried over are listed in skipmap.h. */
+
+/* A node of level l is allocated with its l forward links, followed by its key and its value.
+   Only level 0 has a backward link, for the backward iterators. */
+typedef struct s_MapNode {
+	int level;
+	struct s_MapNode* backward;
+	struct s_MapNode* forward[];
+} MapNode;
+
+struct s_SkipMap {
+	MapNode* sentinel;
+	unsigned int size;
+	size_t key_size;
+	/* Offset of the value from the key, so that the value is aligned. */
+	size_t value_offset;
+	size_t value_size;
+	KeyComparator compare;
+	RNG rng;
+};
+
+int skipmap_compare_int(const void* a, const void* b) {
+	int x = *(const int*)a, y = *(const int*)b;
+	return (x > y) - (x < y);
+}
+
+int skipmap_compare_uint64(const void* a, const void* b) {
+	uint64_t x = *(const uint64_t*)a, y = *(const uint64_t*)b;
+	return (x > y) - (x < y);
+}
+
+int skipmap_compare_string(const void* a, const void* b) {
+	return strcmp(*(const char* const*)a, *(const char* const*)b);
+}
+
+void* mapnode_key(const MapNode* n) {
+	return (void*)(n->forward + n->level);
+}
+
+void* mapnode_value(const SkipMap* m, const MapNode* n) {
+	return (char*)mapnode_key(n) + m->value_offset;
+}
+
+MapNode* mapnode_create(const SkipMap* m, const void* key, const void* value, int level) {
+	MapNode* n = malloc(sizeof(MapNode) + level * sizeof(MapNode*) + m->value_offset + m->value_size);
+	n->level = level;
+	memcpy(mapnode_key(n), key, m->key_size);
+	memcpy(mapnode_value(m, n), value, m->value_size);
+	return n;
+}
+
+SkipMap* skipmap_create(int nblevels, size_t key_size, size_t value_size, KeyComparator compare) {
+	if (nblevels == SKIPLIST_DYNAMIC_LEVELS || nblevels > SKIPLIST_MAX_LEVELS)
+		nblevels = SKIPLIST_MAX_LEVELS;
+	SkipMap* m = malloc(sizeof(SkipMap) + sizeof(MapNode) + nblevels * sizeof(MapNode*));
+	m->sentinel = (MapNode*)(m+1);
+	m->sentinel->level = nblevels;
+	m->sentinel->backward = m->sentinel;
+	for (int i = 0; i < nblevels; i++)
+		m->sentinel->forward[i] = m->sentinel;
+	m->size = 0;
+	m->key_size = key_size;
+	m->value_offset = (key_size + sizeof(void*) - 1) / sizeof(void*) * sizeof(void*);
+	m->value_size = value_size;
+	m->compare = compare;
+	m->rng = rng_initialize_geometric(0, nblevels, 1);
+	return m;
+}
+
+void skipmap_delete(SkipMap** m) {
+	MapNode* n = (*m)->sentinel->forward[0];
+	while (n != (*m)->sentinel) {
+		MapNode* next = n->forward[0];
+		free(n);
+		n = next;
+	}
+	free(*m);
+	*m = NULL;
+}
+
+unsigned int skipmap_size(const SkipMap* m) {
+	return m->size;
+}
+
+/* Last node of each level whose key is lower than key. Returns the next node at level 0. */
+MapNode* skipmap_find(const SkipMap* m, const void* key, MapNode** update) {
+	MapNode* cursor = m->sentinel;
+	for (int cur_l = m->sentinel->level-1; cur_l >= 0; cur_l--) {
+		while (cursor->forward[cur_l] != m->sentinel && m->compare(mapnode_key(cursor->forward[cur_l]), key) < 0)
+			cursor = cursor->forward[cur_l];
+		if (update != NULL)
+			update[cur_l] = cursor;
+	}
+	return cursor->forward[0];
+}
+
+SkipMap* skipmap_put(SkipMap* m, const void* key, const void* value) {
+	MapNode* update[SKIPLIST_MAX_LEVELS];
+	MapNode* n = skipmap_find(m, key, update);
+	if (n != m->sentinel && m->compare(mapnode_key(n), key) == 0) {
+		memcpy(mapnode_value(m, n), value, m->value_size);
+		return m;
+	}
+	int level = rng_get_value(&(m->rng))+1;
+	n = mapnode_create(m, key, value, level);
+	for (int cur_l = 0; cur_l < level; cur_l++) {
+		n->forward[cur_l] = update[cur_l]->forward[cur_l];
+		update[cur_l]->forward[cur_l] = n;
+	}
+	n->backward = update[0];
+	n->forward[0]->backward = n;
+	(m->size)++;
+	return m;
+}
+
+void* skipmap_get(const SkipMap* m, const void* key) {
+	MapNode* n = skipmap_find(m, key, NULL);
+	if (n != m->sentinel && m->compare(mapnode_key(n), key) == 0)
+		return mapnode_value(m, n);
+	return NULL;
+}
+
+bool skipmap_erase(SkipMap* m, const void* key) {
+	MapNode* update[SKIPLIST_MAX_LEVELS];
+	MapNode* n = skipmap_find(m, key, update);
+	if (n == m->sentinel || m->compare(mapnode_key(n), key) != 0)
+		return false;
+	for (int cur_l = 0; cur_l < n->level; cur_l++)
+		update[cur_l]->forward[cur_l] = n->forward[cur_l];
+	n->forward[0]->backward = update[0];
+	(m->size)--;
+	free(n);
+	return true;
+}
+
+/*----------------------------------------------------------------------------------------------*/
+
+struct s_SkipMapIterator {
+	SkipMap* skipmap;
+	MapNode* current;
+	IteratorDirection direction;
+};
+
+SkipMapIterator* skipmap_iterator_create(SkipMap* m, IteratorDirection w) {
+	SkipMapIterator* it = malloc(sizeof(struct s_SkipMapIterator));
+	it->skipmap = m;
+	it->direction = w;
+	return skipmap_iterator_begin(it);
+}
+
+void skipmap_iterator_delete(SkipMapIterator** it) {
+	free(*it);
+	*it = NULL;
+}
+
+SkipMapIterator* skipmap_iterator_begin(SkipMapIterator* it) {
+	MapNode* sentinel = it->skipmap->sentinel;
+	it->current = (it->direction == FORWARD_ITERATOR ? sentinel->forward[0] : sentinel->backward);
+	return it;
+}
+
+bool skipmap_iterator_end(SkipMapIterator* it) {
+	return it->current == it->skipmap->sentinel;
+}
+
+SkipMapIterator* skipmap_iterator_next(SkipMapIterator* it) {
+	it->current = (it->direction == FORWARD_ITERATOR ? it->current->forward[0] : it->current->backward);
+	return it;
+}
+
+const void* skipmap_iterator_key(SkipMapIterator* it) {
+	return mapnode_key(it->current);
+}
+
+void* skipmap_iterator_value(SkipMapIterator* it) {
+	return mapnode_value(it->skipmap, it->current);
+}
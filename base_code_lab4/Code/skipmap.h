@@ -0,0 +1,214 @@
+#ifndef __SKIPMAP_H__
+#define __SKIPMAP_H__
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "skiplist.h"
+
+/**
+ *	@defgroup SkipMapAT SkipMap abstract type
+ *  @brief Definition of the SkipMap type and operators : an ordered dictionary implemented by a skip list.
+ *
+ *  Keys and values are blocks of bytes of a size given at construction, copied inline in the nodes. Keys are ordered by a
+ *  user supplied comparator. A value may be a pointer to some payload managed by the user.
+ *  The macro SKIPMAP_DEFINE generates typed operators for given key and value types.
+ *
+ *  The SkipMap is a separate implementation of the skip list of skiplist.c : the int SkipList caches the key of the next
+ *  node in each link, which a generic key does not allow. A change of the search, insertion or removal of skiplist.c must
+ *  be reported in skipmap.c. The following features of the SkipList are not carried over :
+ *  - the cached keys and the widths of the links : there is no positional access (skiplist_at, skiplist_rank);
+ *  - the pool of removed nodes : each put of a new key allocates a node and each erase frees one;
+ *  - the number of levels following the size : SKIPLIST_DYNAMIC_LEVELS gives SKIPLIST_MAX_LEVELS levels, the searches
+ *    skipping the empty levels of the sentinel;
+ *  - the backward links of the upper levels : only level 0 is linked backward, for the iterators;
+ *  - the range operators, the set operators, the batched search, the binary save and load, the statistics, and the seek
+ *    and erasure through an iterator.
+ *  @{
+ */
+
+/**
+ *	@brief Opaque definition of the SkipMap abstract data type.
+ */
+typedef struct s_SkipMap SkipMap;
+
+/**
+ *	@brief Order of the keys : returns a negative, zero or positive value if the first key is lower, equal or greater than the second one.
+ */
+typedef int(*KeyComparator)(const void*, const void*);
+
+/** @brief Comparator of int keys. */
+int skipmap_compare_int(const void* a, const void* b);
+
+/** @brief Comparator of uint64_t keys. */
+int skipmap_compare_uint64(const void* a, const void* b);
+
+/** @brief Comparator of string keys, the keys being pointers to null terminated strings not owned by the map. */
+int skipmap_compare_string(const void* a, const void* b);
+
+/**
+ *  @brief Constructor of an empty SkipMap.
+ *	@param nblevels the number of levels in the skip map, at most SKIPLIST_MAX_LEVELS, or SKIPLIST_DYNAMIC_LEVELS for
+ *	SKIPLIST_MAX_LEVELS levels.
+ *	@param key_size the size in bytes of the keys.
+ *	@param value_size the size in bytes of the values.
+ *	@param compare the order of the keys.
+ *  @return a correctly initialized SkipMap.
+ */
+SkipMap* skipmap_create(int nblevels, size_t key_size, size_t value_size, KeyComparator compare);
+
+/**
+ *  @brief Destructor of a SkipMap.
+ *	@param m the skipmap to delete.
+ */
+void skipmap_delete(SkipMap** m);
+
+/**
+ *  @brief Access to the number of keys of the SkipMap.
+ *	@param m the SkipMap to access
+ *  @return the number of keys in the SkipMap.
+ */
+unsigned int skipmap_size(const SkipMap* m);
+
+/**
+ *	@brief Associate a value to a key.
+ *	@param m the SkipMap to modify
+ *	@param key the key, whose key_size bytes are copied
+ *	@param value the value, whose value_size bytes are copied, replacing the value previously associated to the key if any
+ *  @return the modified skipmap.
+ *	@note the parameter m is modified by side effect and is returned by the function
+ */
+SkipMap* skipmap_put(SkipMap* m, const void* key, const void* value);
+
+/**
+ *	@brief Access to the value associated to a key.
+ *	@param m the SkipMap to search into
+ *	@param key the key to search for
+ *  @return the address of the value stored in the map, that may be modified in place, or NULL if the key is not in the map.
+ *  @note The address is valid until the key is erased.
+ */
+void* skipmap_get(const SkipMap* m, const void* key);
+
+/**
+ *	@brief Remove a key and its value from the SkipMap.
+ *	@param m the SkipMap to modify
+ *	@param key the key to remove
+ *  @return true if the key was in the map.
+ */
+bool skipmap_erase(SkipMap* m, const void* key);
+
+/*-----------------------*/
+/* Iterator             */
+/*-----------------------*/
+/**
+ * @addtogroup  SkipMapBidirIterator SkipMap bidirectional iterator
+ *  @brief Definition of the SkipMapIterator type and operators, visiting the keys in ascending or descending order.
+ * @{
+ */
+
+/**
+ *	@brief Opaque definition of the SkipMapIterator abstract data type.
+ */
+typedef struct s_SkipMapIterator SkipMapIterator;
+
+/**
+ *	@brief Constructor of an iterator.
+ * @param m the SkipMap to iterate
+ * @param w the way the iterator will go (FORWARD_ITERATOR or BACKWARD_ITERATOR)
+ * @return the correcly initialized iterator
+ */
+SkipMapIterator* skipmap_iterator_create(SkipMap* m, IteratorDirection w);
+
+/**
+ *	@brief Destructor of an iterator.
+ *  @param it the iterator to delete
+ */
+void skipmap_iterator_delete(SkipMapIterator** it);
+
+/**
+ *	@brief Put the iterator at the beginning of its collection.
+ *  @param it the iterator to modify
+ *	@return the modified iterator
+ *	@note the parameter it is modified by side effect and is returned by the function
+ */
+SkipMapIterator* skipmap_iterator_begin(SkipMapIterator* it);
+
+/**
+ *	@brief Test if the iterator is at the end of its collection.
+ *  @param it the iterator to test
+ *  @return true if the iterator is at the end
+ */
+bool skipmap_iterator_end(SkipMapIterator* it);
+
+/**
+ *	@brief Increment the iterator to the next position according to its direction.
+ *  @param it the iterator to modify
+ *	@return the modified iterator
+ *	@note the parameter it is modified by side effect and is returned by the function
+ */
+SkipMapIterator* skipmap_iterator_next(SkipMapIterator* it);
+
+/**
+ *	@brief Acces to the key of the iterator.
+ *  @param it the iterator to access
+ *  @return the address of the key designed by the iterator, that must not be modified.
+ */
+const void* skipmap_iterator_key(SkipMapIterator* it);
+
+/**
+ *	@brief Acces to the value of the iterator.
+ *  @param it the iterator to access
+ *  @return the address of the value designed by the iterator.
+ */
+void* skipmap_iterator_value(SkipMapIterator* it);
+
+/** @} */
+
+/**
+ *	@brief Define typed operators on a SkipMap whose keys are of type key_type and values of type value_type.
+ *	@param name prefix of the generated operators.
+ *	@param key_type the type of the keys.
+ *	@param value_type the type of the values.
+ *	@param compare the KeyComparator of the keys.
+ *
+ *	The generated operators are :
+ *	@code{.c}
+ *	SkipMap* name_create(int nblevels);
+ *	SkipMap* name_put(SkipMap* m, key_type key, value_type value);
+ *	value_type* name_get(const SkipMap* m, key_type key);
+ *	bool name_erase(SkipMap* m, key_type key);
+ *	key_type name_iterator_key(SkipMapIterator* it);
+ *	value_type* name_iterator_value(SkipMapIterator* it);
+ *	@endcode
+ *	For instance, a map from strings to counters :
+ *	@code{.c}
+ *	SKIPMAP_DEFINE(counters, const char*, int, skipmap_compare_string)
+ *	...
+ *	SkipMap* m = counters_create(16);
+ *	counters_put(m, "skip", 1);
+ *	(*counters_get(m, "skip"))++;
+ *	@endcode
+ *  @note The generated functions are static, the macro must be used at file scope in each file that needs the operators.
+ */
+#define SKIPMAP_DEFINE(name, key_type, value_type, compare) \
+static inline SkipMap* name##_create(int nblevels) { \
+	return skipmap_create(nblevels, sizeof(key_type), sizeof(value_type), compare); \
+} \
+static inline SkipMap* name##_put(SkipMap* m, key_type key, value_type value) { \
+	return skipmap_put(m, &key, &value); \
+} \
+static inline value_type* name##_get(const SkipMap* m, key_type key) { \
+	return (value_type*)skipmap_get(m, &key); \
+} \
+static inline bool name##_erase(SkipMap* m, key_type key) { \
+	return skipmap_erase(m, &key); \
+} \
+static inline key_type name##_iterator_key(SkipMapIterator* it) { \
+	return *(const key_type*)skipmap_iterator_key(it); \
+} \
+static inline value_type* name##_iterator_value(SkipMapIterator* it) { \
+	return (value_type*)skipmap_iterator_value(it); \
+}
+
+/** @} */
+
+#endif